@@ -0,0 +1,196 @@
+#ifndef CA_ALPHALABELS_H
+#define CA_ALPHALABELS_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memcpy()
+//
+// Repository
+//   "numutils.h"    -> cardinal, CA_CONSTEXPR
+//   "strview.h"     -> StrView
+//
+
+#include <cstring>
+
+#include "numutils.h"
+#include "strview.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Generowanie kolejnych etykiet literowych (A, B, .., Z, AA, AB, ..)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Wytwarzanie dlugich ciagow etykiet numeracji literowej (bijective base-26, jak nazwy kolumn
+//   arkusza) bez konwersji kazdego indeksu od nowa i bez alokacji pamieci.
+//
+// Zakres odpowiedzialnosci:
+// - Etykieta nastepna powstaje z biezacej przez zwiekszenie jej "w miejscu": koncowe 'Z'
+//   zamieniane sa na 'A' (przeniesienie), a pierwsza litera przed nimi jest zwiekszana; gdy
+//   wszystkie litery to 'Z', na poczatku dopisywane jest 'A' (np. "AZZ" -> "BAA", "ZZ" -> "AAA").
+// - Zapis wielu kolejnych etykiet do ciaglego bufora (Emit) i pojedynczej etykiety do bufora
+//   wywolujacego (IntToAlphaChars).
+// - AlphaCharsGenerator: pojedyncza etykieta wyliczana w czasie kompilacji (dla MakeFixedStr()).
+//
+// Uwagi projektowe:
+// * Przeniesienie dotyka k liter raz na 26^k krokow, wiec sredni koszt kroku jest staly.
+// * Etykieta przechowywana jest wyrownana do konca bufora - dopisanie litery na poczatku nie
+//   wymaga przesuwania pozostalych.
+// * Wynik jest zgodny z IntToAlphaNumStr() w calym zakresie [1..ALPHA_MAX].
+//
+
+#define ALPHA_MAX 321272406  // gorna granica numeracji literowej ("ZZZZZZ")
+
+const cardinal kAlphaCharsMax = 6;   // najdluzsza etykieta: "ZZZZZZ"
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: liczba liter etykiety indeksu <v> (0 dla v == 0; postac constexpr C++11).
+//
+CA_CONSTEXPR cardinal AlphaLength(unsigned v)
+{
+    return (v == 0) ? 0 : 1 + AlphaLength((v - 1) / 26);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: litera nr <k> etykiety indeksu <v>, liczac od najmlodszej (postac constexpr C++11).
+//
+CA_CONSTEXPR char AlphaCharFromEnd(unsigned v, cardinal k)
+{
+    return (k == 0) ? char('A' + (v - 1) % 26) : AlphaCharFromEnd((v - 1) / 26, k - 1);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis etykiety indeksu <value> (1..ALPHA_MAX) do bufora <out> (bez terminatora; bufor musi
+// pomiescic kAlphaCharsMax znakow). Zwraca wskaznik za ostatnim znakiem, a dla wartosci spoza
+// zakresu - <out> (pusty wynik).
+//
+inline char* IntToAlphaChars(int value, char* out)
+{
+    if (value < 1 || ALPHA_MAX < value) return out;
+
+    // Litery od najmlodszej - zapis od konca etykiety
+    unsigned v = static_cast<unsigned>(value);
+    char* end = out + AlphaLength(v);
+    for (char* p = end; v > 0; v = (v - 1) / 26)
+        *--p = char('A' + (v - 1) % 26);
+    return end;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Generator liter etykiety dla MakeFixedStr() - wyliczany w czasie kompilacji.
+// Indeks 0 daje pusta etykiete.
+//
+struct AlphaCharsGenerator
+{
+    unsigned value;   // 0..ALPHA_MAX
+
+    CA_CONSTEXPR cardinal Size() const { return AlphaLength(value); }
+    CA_CONSTEXPR char At(cardinal i) const
+    {
+        return (i >= Size()) ? '\0' : AlphaCharFromEnd(value, Size() - 1 - i);
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Generator kolejnych etykiet w czasie wykonania
+//
+class AlphaLabelGenerator
+{
+public:
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie generatora ustawionego na etykiete indeksu <start> (1-based).
+    // Dla indeksu spoza zakresu [1..ALPHA_MAX] generator jest od razu wyczerpany (Valid() == false).
+    //
+    explicit AlphaLabelGenerator(int start = 1)
+        : begin_(kAlphaCharsMax), index_(start)
+    {
+        if (start < 1 || ALPHA_MAX < start) {
+            index_ = 0;
+            return;
+        }
+        // Jednorazowy rozklad indeksu na litery (od najmlodszej)
+        for (int v = start; v > 0; v = (v - 1) / 26)
+            label_[--begin_] = char('A' + (v - 1) % 26);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Czy biezaca etykieta istnieje (indeks w zakresie [1..ALPHA_MAX]).
+    //
+    bool Valid() const { return index_ != 0; }
+
+    //---------------------------------------------------------------------------------------------
+    // Indeks (1-based) i tekst biezacej etykiety. Widok wskazuje na bufor generatora - jest wazny
+    // do nastepnej zmiany stanu generatora.
+    //
+    int Index() const { return index_; }
+    StrView Label() const { return StrView(label_ + begin_, kAlphaCharsMax - begin_); }
+
+    //---------------------------------------------------------------------------------------------
+    // Przejscie do nastepnej etykiety. Po ALPHA_MAX ("ZZZZZZ") generator jest wyczerpany.
+    //
+    AlphaLabelGenerator& Next()
+    {
+        if (!Valid()) return *this;
+
+        // Przeniesienie: koncowe 'Z' -> 'A', ...
+        cardinal i = kAlphaCharsMax;
+        while (i > begin_ && label_[i - 1] == 'Z') label_[--i] = 'A';
+        // ... zwiekszenie pierwszej litery przed nimi lub dopisanie nowej litery na poczatku
+        if (i > begin_) {
+            label_[i - 1]++;
+        }
+        else if (begin_ > 0) {
+            label_[--begin_] = 'A';
+        }
+        else {
+            index_ = 0;
+            return *this;
+        }
+        index_++;
+        return *this;
+    }
+
+    AlphaLabelGenerator& operator++() { return Next(); }
+
+    //---------------------------------------------------------------------------------------------
+    // Zapis <count> kolejnych etykiet (poczawszy od biezacej) do bufora <out>, kazda zakonczona
+    // znakiem <separator>; generator przechodzi za ostatnia zapisana etykiete. Bufor musi pomiescic
+    // count * (kAlphaCharsMax + 1) znakow. Zapis konczy sie wczesniej po wyczerpaniu zakresu.
+    // Zwraca wskaznik za ostatnim zapisanym znakiem.
+    //
+    char* Emit(cardinal count, char separator, char* out)
+    {
+        for (; count > 0 && Valid(); count--) {
+            const cardinal size = kAlphaCharsMax - begin_;
+            memcpy(out, label_ + begin_, size);
+            out[size] = separator;
+            out += size + 1;
+            Next();
+        }
+        return out;
+    }
+
+private:
+    char label_[kAlphaCharsMax];   // etykieta wyrownana do konca bufora: [begin_ .. kAlphaCharsMax)
+    cardinal begin_;               // poczatek etykiety w buforze
+    int index_;                    // indeks biezacej etykiety (0 - generator wyczerpany)
+};
+
+
+} // namespace cans
+
+
+#endif // CA_ALPHALABELS_H
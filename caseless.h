@@ -0,0 +1,170 @@
+#ifndef CA_CASELESS_H
+#define CA_CASELESS_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstddef>       -> size_t
+//   <cstring>       -> memcpy()
+//   <stdint.h>      -> uint64_t
+//
+// Repository
+//   "numutils.h"    -> cardinal
+//   "strkernels.h"  -> SwarToLower()
+//   "strutils.h"    -> ToLowerAlpha()
+//   "strview.h"     -> StrView
+//
+
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+#include "numutils.h"
+#include "strkernels.h"
+#include "strutils.h"
+#include "strview.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Porownywanie i haszowanie tekstu bez rozrozniania wielkosci liter (ASCII)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Klucze kontenerow asocjacyjnych dopasowywane bez rozrozniania wielkosci liter, bez tworzenia
+//   kopii ToLowercase() przy kazdym wyszukiwaniu, np.:
+//     std::unordered_map<string, int, CaseInsensitiveHash, CaseInsensitiveEqual>
+//     std::map<string, int, CaseInsensitiveLess>
+//
+// Uwagi projektowe:
+// * Wielkosc liter sprowadzana jest "w locie", wg tych samych regul co ToLowerAlpha() (tylko
+//   [A-Z]; pozostale bajty, takze >= 0x80, porownywane sa bez zmian).
+// * Tekst przetwarzany jest slowami 8-bajtowymi (SWAR); tylko koncowka krotsza niz slowo jest
+//   wczytywana czesciowo.
+// * Funktory sa przezroczyste (is_transparent) i przyjmuja StrView - wyszukiwanie kluczem
+//   StrView / C-string (map::find w C++14, unordered_map::find w C++20) nie wymaga alokacji.
+//
+
+//-------------------------------------------------------------------------------------------------
+// Helper: odczyt <n> (<= 8) bajtow do slowa 64-bit; brakujace bajty sa zerami.
+//
+inline uint64_t LoadWordPartial(const char* p, cardinal n)
+{
+    uint64_t w = 0;
+    memcpy(&w, p, n);
+    return w;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Porownanie tekstow bez rozrozniania wielkosci liter ASCII.
+// Zwraca wartosc ujemna, zero lub dodatnia - jak memcmp() na tekstach sprowadzonych do malych liter.
+//
+inline int CompareIgnoreCase(StrView a, StrView b)
+{
+    const cardinal n = (a.size() < b.size()) ? a.size() : b.size();
+
+    cardinal i = 0;
+    // Pomijanie zgodnych slow 8-bajtowych ...
+    for (; i + 8 <= n; i += 8) {
+        uint64_t wa, wb;
+        memcpy(&wa, a.data() + i, 8);
+        memcpy(&wb, b.data() + i, 8);
+        if (SwarToLower(wa) != SwarToLower(wb)) break;
+    }
+    // ... i porownanie znak po znaku od slowa, w ktorym wystapila roznica (lub od koncowki)
+    for (; i < n; i++) {
+        const unsigned char ca = static_cast<unsigned char>(ToLowerAlpha(a[i]));
+        const unsigned char cb = static_cast<unsigned char>(ToLowerAlpha(b[i]));
+        if (ca != cb) return (ca < cb) ? -1 : 1;
+    }
+    // Wspolny poczatek zgodny - krotszy tekst jest mniejszy
+    if (a.size() == b.size()) return 0;
+    return (a.size() < b.size()) ? -1 : 1;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Sprawdzenie rownosci tekstow bez rozrozniania wielkosci liter ASCII.
+//
+inline bool EqualsIgnoreCase(StrView a, StrView b)
+{
+    if (a.size() != b.size()) return false;
+
+    const cardinal n = a.size();
+    cardinal i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t wa, wb;
+        memcpy(&wa, a.data() + i, 8);
+        memcpy(&wb, b.data() + i, 8);
+        if (SwarToLower(wa) != SwarToLower(wb)) return false;
+    }
+    // Koncowka krotsza niz slowo - uzupelniona zerami w obu tekstach
+    return (i == n) || SwarToLower(LoadWordPartial(a.data() + i, n - i)) ==
+                       SwarToLower(LoadWordPartial(b.data() + i, n - i));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Skrot (hash) tekstu niezalezny od wielkosci liter ASCII: teksty rowne wg EqualsIgnoreCase()
+// maja rowne skroty.
+//
+inline size_t HashIgnoreCase(StrView view)
+{
+    const uint64_t kMul = 0x9E3779B97F4A7C15ULL;
+    const cardinal n = view.size();
+    uint64_t h = static_cast<uint64_t>(n) * kMul;
+
+    cardinal i = 0;
+    // Mieszanie kolejnych slow 8-bajtowych sprowadzonych do malych liter ...
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        memcpy(&w, view.data() + i, 8);
+        h = (h ^ SwarToLower(w)) * kMul;
+        h ^= h >> 29;
+    }
+    // ... oraz koncowki (uzupelnionej zerami)
+    if (i < n) {
+        h = (h ^ SwarToLower(LoadWordPartial(view.data() + i, n - i))) * kMul;
+        h ^= h >> 29;
+    }
+    // Ostateczne wymieszanie bitow (dla tablic indeksowanych mlodszymi bitami skrotu)
+    h ^= h >> 32;
+    h *= kMul;
+    h ^= h >> 29;
+    return static_cast<size_t>(h);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Funktory dla kontenerow standardowych
+//
+struct CaseInsensitiveHash
+{
+    typedef void is_transparent;
+    size_t operator()(StrView view) const { return HashIgnoreCase(view); }
+};
+
+struct CaseInsensitiveEqual
+{
+    typedef void is_transparent;
+    bool operator()(StrView a, StrView b) const { return EqualsIgnoreCase(a, b); }
+};
+
+struct CaseInsensitiveLess
+{
+    typedef void is_transparent;
+    bool operator()(StrView a, StrView b) const { return CompareIgnoreCase(a, b) < 0; }
+};
+
+
+} // namespace cans
+
+
+#endif // CA_CASELESS_H
@@ -0,0 +1,261 @@
+#ifndef CA_CELLREF_H
+#define CA_CELLREF_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <stdint.h>      -> uint64_t
+//   <vector>        -> std::vector
+//
+// Repository
+//   "numutils.h"    -> cardinal, TParseResult
+//   "intformat.h"   -> UIntToChars()
+//   "intparse.h"    -> ScanDecimalUInt()
+//   "alphalabels.h" -> kAlphaCharsMax, IntToAlphaChars()
+//   "strconverters.h" -> AlphaNumStrToInt()
+//   "strview.h"     -> StrView
+//
+
+#include <stdint.h>
+#include <vector>
+
+#include "numutils.h"
+#include "intformat.h"
+#include "intparse.h"
+#include "alphalabels.h"
+#include "strconverters.h"
+#include "strview.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Adresy komorek arkusza (notacja A1)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Odczyt i zapis adresow komorek ("AB1234", "$C$3") oraz zakresow ("C3:ZZ9000") bez tworzenia
+//   tekstow posrednich - z zakresu wskaznikow do struktury (wiersz, kolumna) i z powrotem
+//   do bufora wywolujacego.
+//
+// Zakres odpowiedzialnosci:
+// - Kolumna: litery [A-Z] numeracji literowej (jak AlphaNumStrToInt()), wiersz: liczba dziesietna
+//   >= 1 bez zer wiodacych (jak StrToInt(), lecz bez znaku); kazda czesc moze byc poprzedzona
+//   kotwica '$' (adres bezwzgledny).
+// - Walidacja granic: kolumna <= <maxCol>, wiersz <= <maxRow> (domyslnie granice arkusza Excel).
+// - Wersje wsadowe dla tablic adresow i zakresow (pola niepoprawne - indeksy w liscie bledow).
+//
+// Uwagi projektowe:
+// * Adres odczytywany jest w jednym przejsciu: kolumne i wiersz odczytuja wprost z zakresu
+//   wskaznikow AlphaNumStrToInt(first, last) i ScanDecimalUInt() - bez wydzielania czesci do
+//   osobnych tekstow; zapis kolumny wykonuje IntToAlphaChars().
+// * Zakres bez ':' (pojedynczy adres) jest zakresem jednej komorki; kolejnosc naroznikow
+//   zakresu nie jest zmieniana.
+//
+
+const int kCellRowMax = 1048576;   // domyslna granica wiersza (arkusz Excel)
+const int kCellColMax = 16384;     // domyslna granica kolumny ("XFD")
+
+const cardinal kCellRefCharsMax = 1 + kAlphaCharsMax + 1 + 10;         // "$" litery "$" cyfry
+const cardinal kCellRangeCharsMax = 2 * kCellRefCharsMax + 1;          // adres ":" adres
+
+
+//-------------------------------------------------------------------------------------------------
+// Adres komorki (wiersz i kolumna 1-based oraz kotwice '$')
+//
+struct TCellRef
+{
+    int row;
+    int col;
+    bool rowAbsolute;
+    bool colAbsolute;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Zakres komorek (dwa narozniki)
+//
+struct TCellRange
+{
+    TCellRef first;
+    TCellRef last;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: odczyt adresu od <p> (przesuwanego za adres) do co najwyzej <end>. Nie wymaga, aby
+// adres konczyl tekst. Zwraca false dla adresu niepoprawnego lub spoza granic.
+//
+inline bool ScanCellRef(const char*& p, const char* end, TCellRef& ref, int maxRow, int maxCol)
+{
+    const char* q = p;
+
+    // Kolumna: [$]litery numeracji literowej
+    const bool colAbsolute = (q < end && *q == '$');
+    if (colAbsolute) q++;
+    int col;
+    const TParseResult letters = AlphaNumStrToInt(q, end, col);
+    if (letters.error != ParseOk || col > maxCol) return false;
+    q = letters.ptr;
+
+    // Wiersz: [$]cyfry (pierwsza niezerowa - bez znaku i bez zer wiodacych)
+    const bool rowAbsolute = (q < end && *q == '$');
+    if (rowAbsolute) q++;
+    if (q == end || *q < '1' || *q > '9') return false;
+    uint64_t row;
+    const TParseResult digits = ScanDecimalUInt(q, end, static_cast<uint64_t>(maxRow), row);
+    if (digits.error != ParseOk) return false;
+    q = digits.ptr;
+
+    ref.row = static_cast<int>(row);
+    ref.col = col;
+    ref.rowAbsolute = rowAbsolute;
+    ref.colAbsolute = colAbsolute;
+    p = q;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt adresu komorki z <n> znakow <p> (caly tekst musi byc adresem).
+// Zwraca false dla tekstu niepoprawnego lub adresu spoza granic (<out> pozostaje bez zmian).
+//
+inline bool ParseCellRef(const char* p, cardinal n, TCellRef& out,
+                         int maxRow = kCellRowMax, int maxCol = kCellColMax)
+{
+    const char* end = p + n;
+    TCellRef ref;
+    if (!ScanCellRef(p, end, ref, maxRow, maxCol) || p != end) return false;
+
+    out = ref;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt zakresu komorek "adres:adres" (lub pojedynczego adresu) z <n> znakow <p>.
+// Zwraca false dla tekstu niepoprawnego lub adresu spoza granic (<out> pozostaje bez zmian).
+//
+inline bool ParseCellRange(const char* p, cardinal n, TCellRange& out,
+                           int maxRow = kCellRowMax, int maxCol = kCellColMax)
+{
+    const char* end = p + n;
+    TCellRange range;
+    if (!ScanCellRef(p, end, range.first, maxRow, maxCol)) return false;
+
+    if (p == end) {
+        range.last = range.first;
+    }
+    else {
+        if (*p != ':') return false;
+        p++;
+        if (!ScanCellRef(p, end, range.last, maxRow, maxCol) || p != end) return false;
+    }
+
+    out = range;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis adresu komorki do bufora <out> (bez terminatora; bufor musi pomiescic kCellRefCharsMax
+// znakow). Adres powinien byc poprawny (wiersz i kolumna >= 1). Zwraca wskaznik za ostatnim
+// znakiem.
+//
+inline char* CellRefToChars(const TCellRef& ref, char* out)
+{
+    if (ref.colAbsolute) *out++ = '$';
+    out = IntToAlphaChars(ref.col, out);
+    if (ref.rowAbsolute) *out++ = '$';
+    return UIntToChars(static_cast<unsigned>(ref.row), out);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis zakresu komorek "adres:adres" do bufora <out> (bufor musi pomiescic kCellRangeCharsMax
+// znakow). Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* CellRangeToChars(const TCellRange& range, char* out)
+{
+    out = CellRefToChars(range.first, out);
+    *out++ = ':';
+    return CellRefToChars(range.last, out);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt tablicy adresow. Pola niepoprawne dostaja adres zerowy, a ich indeksy trafiaja
+// (rosnaco) do <failures>. Zwraca liczbe pol poprawnych.
+//
+inline cardinal ParseCellRefs(const StrView* inputs, cardinal count, TCellRef* out,
+                              std::vector<cardinal>& failures,
+                              int maxRow = kCellRowMax, int maxCol = kCellColMax)
+{
+    const TCellRef kNone = { 0, 0, false, false };
+    failures.clear();
+    for (cardinal i = 0; i < count; i++) {
+        if (!ParseCellRef(inputs[i].data(), inputs[i].size(), out[i], maxRow, maxCol)) {
+            failures.push_back(i);
+            out[i] = kNone;
+        }
+    }
+    return count - failures.size();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt tablicy zakresow (jak ParseCellRefs()).
+//
+inline cardinal ParseCellRanges(const StrView* inputs, cardinal count, TCellRange* out,
+                                std::vector<cardinal>& failures,
+                                int maxRow = kCellRowMax, int maxCol = kCellColMax)
+{
+    const TCellRange kNone = { { 0, 0, false, false }, { 0, 0, false, false } };
+    failures.clear();
+    for (cardinal i = 0; i < count; i++) {
+        if (!ParseCellRange(inputs[i].data(), inputs[i].size(), out[i], maxRow, maxCol)) {
+            failures.push_back(i);
+            out[i] = kNone;
+        }
+    }
+    return count - failures.size();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis tablicy adresow do bufora <out>, z <separator> po kazdym adresie. Bufor musi pomiescic
+// count * (kCellRefCharsMax + 1) znakow. Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* CellRefsToChars(const TCellRef* refs, cardinal count, char separator, char* out)
+{
+    for (cardinal i = 0; i < count; i++) {
+        out = CellRefToChars(refs[i], out);
+        *out++ = separator;
+    }
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis tablicy zakresow do bufora <out>, z <separator> po kazdym zakresie. Bufor musi pomiescic
+// count * (kCellRangeCharsMax + 1) znakow. Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* CellRangesToChars(const TCellRange* ranges, cardinal count, char separator, char* out)
+{
+    for (cardinal i = 0; i < count; i++) {
+        out = CellRangeToChars(ranges[i], out);
+        *out++ = separator;
+    }
+    return out;
+}
+
+
+} // namespace cans
+
+
+#endif // CA_CELLREF_H
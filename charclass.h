@@ -0,0 +1,285 @@
+#ifndef CA_CHARCLASS_H
+#define CA_CHARCLASS_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <stdint.h>      -> uint64_t
+//
+// Repository
+//   "numutils.h"    -> cardinal, CA_CONSTEXPR, CA_CONSTEXPR_DATA
+//   "strkernels.h"  -> CA_SIMD_X86, CA_TARGET_AVX2, SimdLevel, ActiveSimdLevel()
+//
+
+#include <stdint.h>
+
+#include "numutils.h"
+#include "strkernels.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Klasyfikacja znakow ASCII (tablicowa i blokowa)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Klasyfikacja wielu znakow naraz - na wzor pierwszego etapu simdjson. Dla bloku 64 bajtow
+//   wyznaczane sa 64-bitowe maski (bit i = bajt i) dla kazdej klasy znakow. Parsery wyzszych
+//   warstw moga nastepnie znajdowac granice pol i ciagi cyfr operacjami bitowymi na maskach,
+//   zamiast rozgalezienia na kazdym bajcie.
+//
+// Uwagi projektowe:
+// * Klasy odpowiadaja predykatom z strutils.h: IsAsciiWhitespace(), IsAsciiDigit(),
+//   IsAsciiColon() / IsAsciiSemicolon() (separator), IsAsciiAlpha(), IsAsciiDot().
+// * Klasyfikacja nie zalezy od ustawien lokalnych (locale).
+// * Koncowki krotsze niz blok klasyfikowane sa przez 256-elementowa tablice klas.
+//
+
+//-------------------------------------------------------------------------------------------------
+// Klasy znakow (flagi bitowe)
+//
+enum CharClass
+{
+    CharClassNone       = 0,
+    CharClassWhitespace = 1,    // '\t', '\n', '\v', '\f', '\r', ' '
+    CharClassDigit      = 2,    // [0-9]
+    CharClassSeparator  = 4,    // [,;]
+    CharClassAlpha      = 8,    // [A-Za-z]
+    CharClassDot        = 16    // [.]
+};
+
+
+#define W_ CharClassWhitespace
+#define D_ CharClassDigit
+#define S_ CharClassSeparator
+#define A_ CharClassAlpha
+#define P_ CharClassDot
+
+//-------------------------------------------------------------------------------------------------
+// Tablica klas znakow (indeks = kod znaku 0..255, wartosc = suma flag CharClass).
+//
+static CA_CONSTEXPR_DATA unsigned char kAsciiClassTable[256] =
+{
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  W_, W_, W_, W_, W_, 0,  0,     // 0x00
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,     // 0x10
+    W_, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  S_, 0,  P_, 0,     // 0x20
+    D_, D_, D_, D_, D_, D_, D_, D_, D_, D_, 0,  S_, 0,  0,  0,  0,     // 0x30
+    0,  A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_,    // 0x40
+    A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, 0,  0,  0,  0,  0,     // 0x50
+    0,  A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_,    // 0x60
+    A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, 0,  0,  0,  0,  0,     // 0x70
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,     // 0x80
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,     // 0x90
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,     // 0xA0
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,     // 0xB0
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,     // 0xC0
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,     // 0xD0
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,     // 0xE0
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0      // 0xF0
+};
+
+#undef W_
+#undef D_
+#undef S_
+#undef A_
+#undef P_
+
+
+//-------------------------------------------------------------------------------------------------
+// Klasa znaku ASCII (suma flag CharClass) - odczyt z tablicy, bez zaleznosci od locale.
+//
+CA_CONSTEXPR unsigned AsciiCharClass(char ch)
+{
+    return kAsciiClassTable[static_cast<unsigned char>(ch)];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Maski klas dla bloku do 64 znakow (bit i odpowiada znakowi i bloku)
+//
+struct TCharClassMasks
+{
+    uint64_t whitespace;
+    uint64_t digit;
+    uint64_t separator;
+    uint64_t alpha;
+    uint64_t dot;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Klasyfikacja bloku <n> znakow (n <= 64) - wariant tablicowy (referencyjny, takze dla koncowek).
+// Bity masek powyzej <n> sa zerowe.
+//
+inline void ClassifyBlockScalar(const char* p, cardinal n, TCharClassMasks& out)
+{
+    out.whitespace = out.digit = out.separator = out.alpha = out.dot = 0;
+    // Iteracja po znakach bloku ...
+    for (cardinal i = 0; i < n; i++) {
+        // ... i rozlozenie flag klasy znaku na bity odpowiednich masek
+        const uint64_t c = kAsciiClassTable[static_cast<unsigned char>(p[i])];
+        out.whitespace |= (c & 1) << i;
+        out.digit      |= ((c >> 1) & 1) << i;
+        out.separator  |= ((c >> 2) & 1) << i;
+        out.alpha      |= ((c >> 3) & 1) << i;
+        out.dot        |= ((c >> 4) & 1) << i;
+    }
+}
+
+
+#if defined(CA_SIMD_X86)
+
+//-------------------------------------------------------------------------------------------------
+// Klasyfikacja pelnego bloku 64 znakow - wariant SSE2 (4 rejestry po 16 bajtow).
+//
+inline void ClassifyBlock64Sse2(const char* p, TCharClassMasks& out)
+{
+    out.whitespace = out.digit = out.separator = out.alpha = out.dot = 0;
+
+    for (int k = 0; k < 4; k++)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+        // Biale znaki: spacja lub zakres ['\t'..'\r'] (porownania ze znakiem - bajty >= 0x80
+        // sa ujemne, wiec nie trafiaja w zakresy ASCII)
+        const __m128i ws = _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+            _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('\t' - 1)),
+                          _mm_cmplt_epi8(v, _mm_set1_epi8('\r' + 1))));
+        const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                            _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+        const __m128i sep = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(',')),
+                                         _mm_cmpeq_epi8(v, _mm_set1_epi8(';')));
+        // Litery: po ustawieniu bitu 0x20 wielkie litery staja sie malymi
+        const __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        const __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)),
+                                            _mm_cmplt_epi8(folded, _mm_set1_epi8('z' + 1)));
+        const __m128i dot = _mm_cmpeq_epi8(v, _mm_set1_epi8('.'));
+
+        const int shift = 16 * k;
+        out.whitespace |= uint64_t(unsigned(_mm_movemask_epi8(ws))) << shift;
+        out.digit      |= uint64_t(unsigned(_mm_movemask_epi8(digit))) << shift;
+        out.separator  |= uint64_t(unsigned(_mm_movemask_epi8(sep))) << shift;
+        out.alpha      |= uint64_t(unsigned(_mm_movemask_epi8(alpha))) << shift;
+        out.dot        |= uint64_t(unsigned(_mm_movemask_epi8(dot))) << shift;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Klasyfikacja pelnego bloku 64 znakow - wariant AVX2 (2 rejestry po 32 bajty).
+//
+CA_TARGET_AVX2
+inline void ClassifyBlock64Avx2(const char* p, TCharClassMasks& out)
+{
+    out.whitespace = out.digit = out.separator = out.alpha = out.dot = 0;
+
+    for (int k = 0; k < 2; k++)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * k));
+        // Jak w ClassifyBlock64Sse2(), z porownaniem "mniejszy niz" zapisanym jako cmpgt(b, a)
+        const __m256i ws = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+            _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('\t' - 1)),
+                             _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), v)));
+        const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                                               _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+        const __m256i sep = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')),
+                                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8(';')));
+        const __m256i folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        const __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(folded, _mm256_set1_epi8('a' - 1)),
+                                               _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), folded));
+        const __m256i dot = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.'));
+
+        const int shift = 32 * k;
+        out.whitespace |= uint64_t(unsigned(_mm256_movemask_epi8(ws))) << shift;
+        out.digit      |= uint64_t(unsigned(_mm256_movemask_epi8(digit))) << shift;
+        out.separator  |= uint64_t(unsigned(_mm256_movemask_epi8(sep))) << shift;
+        out.alpha      |= uint64_t(unsigned(_mm256_movemask_epi8(alpha))) << shift;
+        out.dot        |= uint64_t(unsigned(_mm256_movemask_epi8(dot))) << shift;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Klasyfikacja kolejnych blokow - warianty wektorowe (koncowka - wariant tablicowy).
+//
+inline cardinal ClassifyBlocksSse2(const char* p, cardinal n, TCharClassMasks* out)
+{
+    cardinal k = 0;
+    for (; (k + 1) * 64 <= n; k++)
+        ClassifyBlock64Sse2(p + 64 * k, out[k]);
+    if (64 * k < n) {
+        ClassifyBlockScalar(p + 64 * k, n - 64 * k, out[k]);
+        k++;
+    }
+    return k;
+}
+
+CA_TARGET_AVX2
+inline cardinal ClassifyBlocksAvx2(const char* p, cardinal n, TCharClassMasks* out)
+{
+    cardinal k = 0;
+    for (; (k + 1) * 64 <= n; k++)
+        ClassifyBlock64Avx2(p + 64 * k, out[k]);
+    if (64 * k < n) {
+        ClassifyBlockScalar(p + 64 * k, n - 64 * k, out[k]);
+        k++;
+    }
+    return k;
+}
+
+#endif // CA_SIMD_X86
+
+
+//-------------------------------------------------------------------------------------------------
+// Klasyfikacja kolejnych blokow - wariant tablicowy.
+//
+inline cardinal ClassifyBlocksScalar(const char* p, cardinal n, TCharClassMasks* out)
+{
+    cardinal k = 0;
+    for (; 64 * k < n; k++) {
+        const cardinal rest = n - 64 * k;
+        ClassifyBlockScalar(p + 64 * k, (rest < 64) ? rest : 64, out[k]);
+    }
+    return k;
+}
+
+
+typedef cardinal (*ClassifyBlocksKernel)(const char* p, cardinal n, TCharClassMasks* out);
+
+//-------------------------------------------------------------------------------------------------
+// Wybor wariantu klasyfikacji blokowej dla biezacego procesora.
+//
+inline ClassifyBlocksKernel SelectClassifyBlocksKernel(SimdLevel level)
+{
+#if defined(CA_SIMD_X86)
+    if (level >= SimdAvx2) return &ClassifyBlocksAvx2;
+    if (level >= SimdSse2) return &ClassifyBlocksSse2;
+#endif
+    (void)level;
+    return &ClassifyBlocksScalar;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Klasyfikacja <n> znakow bufora <p> blokami po 64 znaki.
+// Tablica <out> musi pomiescic (n + 63) / 64 elementow; zwracana jest liczba zapisanych blokow.
+// W ostatnim, niepelnym bloku bity masek za koncem danych sa zerowe.
+//
+inline cardinal ClassifyBlocks(const char* p, cardinal n, TCharClassMasks* out)
+{
+    static const ClassifyBlocksKernel kernel = SelectClassifyBlocksKernel(ActiveSimdLevel());
+    return kernel(p, n, out);
+}
+
+
+} // namespace cans
+
+
+#endif // CA_CHARCLASS_H
@@ -0,0 +1,141 @@
+#ifndef CA_CHARSET_H
+#define CA_CHARSET_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <stdint.h>   -> uint64_t
+//
+// Repository
+//   "numutils.h" -> cardinal
+//
+
+#include <stdint.h>
+
+#include "numutils.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Zbior znakow (8-bit)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Prekompilowany zbior znakow do wielokrotnego uzytku. Test przynaleznosci jest pojedynczym
+//   odczytem z mapy bitowej 256-bit, niezaleznie od liczebnosci zbioru.
+//
+// Uwagi projektowe:
+// * W odroznieniu od zbioru zadanego C-stringiem, elementem zbioru moze byc znak '\0'.
+// * Obok mapy bitowej utrzymywane sa tablice polbajtowe (nibble) dla jader wektorowych
+//   (pshufb) - patrz RemoveCharsBlock() w strkernels.h.
+//
+
+class CharSet
+{
+public:
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie pustego zbioru.
+    //
+    CharSet()
+    {
+        Clear();
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie zbioru ze znakow lancucha <cstr> (C-string zakonczony '\0', NULL = pusty zbior).
+    //
+    explicit CharSet(const char* cstr)
+    {
+        Clear();
+        // Dodanie do zbioru kolejnych znakow lancucha (az do terminatora)
+        for (const char* c = cstr; c && *c; c++)
+            Insert(*c);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie zbioru z <n> znakow bufora <chars> (dopuszczalny znak '\0').
+    //
+    CharSet(const char* chars, cardinal n)
+    {
+        Clear();
+        // Dodanie do zbioru wszystkich znakow bufora
+        for (cardinal i = 0; i < n; i++)
+            Insert(chars[i]);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Usuniecie wszystkich znakow ze zbioru.
+    //
+    void Clear()
+    {
+        for (cardinal i = 0; i < 4; i++)
+            bits_[i] = 0;
+        for (cardinal i = 0; i < 16; i++)
+            nibbleLo_[i] = nibbleHi_[i] = 0;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Dodanie znaku do zbioru.
+    //
+    void Insert(char ch)
+    {
+        const unsigned char b = static_cast<unsigned char>(ch);
+        // Ustawienie bitu w mapie 256-bit, ...
+        bits_[b >> 6] |= uint64_t(1) << (b & 63);
+        // ... oraz w tablicy polbajtowej: indeks = mlodszy polbajt, bit = starszy polbajt (mod 8)
+        unsigned char* row = (b < 0x80) ? nibbleLo_ : nibbleHi_;
+        row[b & 0x0F] |= static_cast<unsigned char>(1u << ((b >> 4) & 7));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Sprawdzenie, czy znak nalezy do zbioru.
+    //
+    bool Contains(char ch) const
+    {
+        const unsigned char b = static_cast<unsigned char>(ch);
+        return (bits_[b >> 6] >> (b & 63)) & 1;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Sprawdzenie, czy zbior jest pusty.
+    //
+    bool Empty() const
+    {
+        return (bits_[0] | bits_[1] | bits_[2] | bits_[3]) == 0;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Tablice polbajtowe dla jader wektorowych (po 16 bajtow): bit h w elemencie [l] oznacza,
+    // ze do zbioru nalezy znak (h << 4 | l) - dla znakow 0x00..0x7F, lub ((h + 8) << 4 | l).
+    //
+    const unsigned char* NibbleTableLo() const { return nibbleLo_; }
+    const unsigned char* NibbleTableHi() const { return nibbleHi_; }
+
+private:
+    uint64_t bits_[4];
+    unsigned char nibbleLo_[16];
+    unsigned char nibbleHi_[16];
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Utworzenie zbioru z listy znakow podanej w czasie kompilacji, np. CharSetOf<',', ';', '\0'>().
+//
+template <char... Chars>
+inline CharSet CharSetOf()
+{
+    const char chars[] = { Chars..., '\0' };
+    return CharSet(chars, sizeof...(Chars));
+}
+
+
+} // namespace cans
+
+
+#endif // CA_CHARSET_H
@@ -0,0 +1,315 @@
+#ifndef CA_CHARTRANSLATOR_H
+#define CA_CHARTRANSLATOR_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memmove(), strlen()
+//   <string>        -> std::string
+//
+// Repository
+//   "numutils.h"    -> cardinal
+//   "charset.h"     -> CharSet
+//   "strkernels.h"  -> AsciiLowercaseBlock(), AsciiUppercaseBlock(), TranslateSparseBlock(),
+//                      TranslateTableScalar(), RemoveCharsCopyBlock()
+//   "strutils.h"    -> ToLowerAlpha(), ToUpperAlpha()
+//   "strview.h"     -> StrView
+//
+
+#include <cstring>
+#include <string>
+
+#include "numutils.h"
+#include "charset.h"
+#include "strkernels.h"
+#include "strutils.h"
+#include "strview.h"
+
+
+
+
+namespace cans
+{
+    using std::string;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Tablicowe odwzorowanie znakow (na wzor uniksowego tr)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Zamiana wielu znakow naraz jednym przebiegiem po tekscie, np.:
+//     CharTranslator(",;:|\t", "_")           // jak: tr ',;:|\t' '_'
+//     CharTranslator().Delete("\r")           // jak: tr -d '\r'
+//   zamiast wielokrotnego wywolania ReplaceCharInPlace() (jeden pelny przebieg na znak).
+//
+// Zakres odpowiedzialnosci:
+// - Tablica 256 odwzorowan bajt wejsciowy -> bajt wynikowy oraz zbior bajtow wejsciowych
+//   usuwanych z wyniku. Usuwanie dotyczy bajtow wejsciowych (przed odwzorowaniem), jak w tr -d.
+// - Skladanie odwzorowan (Then) - wynik identyczny z wykonaniem ich po kolei.
+//
+// Uwagi projektowe:
+// * Przy kazdej zmianie tablicy ustalany jest rodzaj odwzorowania, od ktorego zalezy jadro:
+//   tozsamosc (kopiowanie), zamiana wielkosci liter (jadra AsciiLowercaseBlock /
+//   AsciiUppercaseBlock - bez utraty szybkosci wzgledem MakeLowercase / MakeUppercase),
+//   nieliczne zmiany (porownania wektorowe) albo odwzorowanie ogolne (tablica bajtow).
+// * Wyszukiwanie w tablicy 256 bajtow przez pshufb (16 tablic po 16 bajtow) nie jest szybsze
+//   od zwyklego odczytu tablicy, stad odwzorowanie ogolne pozostaje tablicowe.
+//
+
+class CharTranslator
+{
+public:
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie odwzorowania tozsamosciowego (bez zmian).
+    //
+    CharTranslator()
+    {
+        for (cardinal b = 0; b < 256; b++)
+            map_[b] = static_cast<char>(b);
+        Classify();
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie odwzorowania znakow <from> na odpowiadajace im znaki <to> (C-stringi, jak tr).
+    //
+    CharTranslator(const char* from, const char* to)
+    {
+        for (cardinal b = 0; b < 256; b++)
+            map_[b] = static_cast<char>(b);
+        Classify();
+        Map(from, to);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Odwzorowania predefiniowane: zamiana wielkich liter ASCII na male / malych na wielkie.
+    //
+    static CharTranslator Lowercase()
+    {
+        CharTranslator t;
+        for (cardinal b = 0; b < 256; b++)
+            t.map_[b] = ToLowerAlpha(char(b));
+        t.Classify();
+        return t;
+    }
+
+    static CharTranslator Uppercase()
+    {
+        CharTranslator t;
+        for (cardinal b = 0; b < 256; b++)
+            t.map_[b] = ToUpperAlpha(char(b));
+        t.Classify();
+        return t;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Odwzorowanie znaku <from> na <to>.
+    //
+    CharTranslator& Map(char from, char to)
+    {
+        map_[static_cast<unsigned char>(from)] = to;
+        Classify();
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Odwzorowanie kolejnych znakow <from> na odpowiadajace im znaki <to> (C-stringi).
+    // Gdy <to> jest krotszy, jego ostatni znak odpowiada pozostalym znakom <from> (jak w tr).
+    // Pusty lub NULL <to> - brak zmian.
+    //
+    CharTranslator& Map(const char* from, const char* to)
+    {
+        if (!from || !to || !*to) return *this;
+
+        const cardinal last = strlen(to) - 1;
+        for (cardinal i = 0; from[i]; i++)
+            map_[static_cast<unsigned char>(from[i])] = to[(i < last) ? i : last];
+        Classify();
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Odwzorowanie wszystkich znakow zbioru <from> na znak <to>.
+    //
+    CharTranslator& Map(const CharSet& from, char to)
+    {
+        for (cardinal b = 0; b < 256; b++) {
+            if (from.Contains(char(b))) map_[b] = to;
+        }
+        Classify();
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Usuwanie z wyniku znakow wejsciowych nalezacych do zbioru (jak tr -d).
+    //
+    CharTranslator& Delete(const CharSet& charset)
+    {
+        for (cardinal b = 0; b < 256; b++) {
+            if (charset.Contains(char(b))) deleted_.Insert(char(b));
+        }
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Usuwanie z wyniku znakow podanych w lancuchu <charset> (C-string, NULL = brak zmian).
+    //
+    CharTranslator& Delete(const char* charset)
+    {
+        return Delete(CharSet(charset));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Usuwanie z wyniku wszystkich wystapien danego znaku.
+    //
+    CharTranslator& Delete(char ch)
+    {
+        deleted_.Insert(ch);
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Zlozenie z odwzorowaniem <next> wykonywanym po biezacym: bajt wejsciowy jest usuwany, gdy
+    // usuwa go biezace odwzorowanie lub gdy <next> usuwa jego obraz.
+    //
+    CharTranslator& Then(const CharTranslator& next)
+    {
+        for (cardinal b = 0; b < 256; b++) {
+            if (next.Deletes(map_[b])) deleted_.Insert(char(b));
+            map_[b] = next.TranslateChar(map_[b]);
+        }
+        Classify();
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Obraz pojedynczego znaku oraz sprawdzenie, czy znak jest usuwany.
+    //
+    char TranslateChar(char ch) const { return map_[static_cast<unsigned char>(ch)]; }
+    bool Deletes(char ch) const { return deleted_.Contains(ch); }
+
+    //---------------------------------------------------------------------------------------------
+    // Przeksztalcenie <n> znakow <src> z zapisem do <dst> (dopuszczalne dst <= src; osobny bufor
+    // musi pomiescic <n> znakow). Zwraca liczbe zapisanych znakow.
+    //
+    cardinal TranslateBlock(const char* src, cardinal n, char* dst) const
+    {
+        // Usuwanie dotyczy bajtow wejsciowych - najpierw kompaktowanie, potem odwzorowanie w miejscu
+        if (!deleted_.Empty()) {
+            n = RemoveCharsCopyBlock(src, n, dst, deleted_);
+            src = dst;
+        }
+        if (n == 0) return 0;
+
+        switch (kind_)
+        {
+        case KindIdentity:
+            if (dst != src) memmove(dst, src, n);
+            break;
+        case KindLowercase:
+            if (dst != src) memmove(dst, src, n);
+            AsciiLowercaseBlock(dst, n);
+            break;
+        case KindUppercase:
+            if (dst != src) memmove(dst, src, n);
+            AsciiUppercaseBlock(dst, n);
+            break;
+        case KindSparse:
+            TranslateSparseBlock(src, n, dst, map_, changed_, changedCount_);
+            break;
+        default:
+            TranslateTableScalar(src, n, dst, map_);
+            break;
+        }
+        return n;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Przeksztalcenie tekstu <str> (modyfikacja in-place).
+    //
+    void TranslateInPlace(string& str) const
+    {
+        if (str.empty()) return;
+        str.resize(TranslateBlock(&str[0], str.size(), &str[0]));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Przeksztalcenie tekstu <in> z zapisem do <out> (poprzednia tresc <out> jest zastepowana).
+    // <in> nie moze wskazywac na tresc <out>.
+    //
+    void TranslateTo(StrView in, string& out) const
+    {
+        out.resize(in.size());
+        if (in.empty()) return;
+        out.resize(TranslateBlock(in.data(), in.size(), &out[0]));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Przeksztalcenie tekstu <in> (zwraca nowy tekst).
+    //
+    string Translate(StrView in) const
+    {
+        string out;
+        TranslateTo(in, out);
+        return out;
+    }
+
+private:
+    //---------------------------------------------------------------------------------------------
+    // Rodzaje odwzorowania (wybor jadra)
+    //
+    enum Kind
+    {
+        KindIdentity,     // brak zmian
+        KindLowercase,    // jak ToLowerAlpha()
+        KindUppercase,    // jak ToUpperAlpha()
+        KindSparse,       // zmienia sie najwyzej kMaxSparse bajtow
+        KindTable         // odwzorowanie ogolne
+    };
+
+    static const cardinal kMaxSparse = 12;   // powyzej - odwzorowanie tablicowe jest szybsze
+
+    //---------------------------------------------------------------------------------------------
+    // Ustalenie rodzaju odwzorowania i listy bajtow zmienianych (po kazdej zmianie tablicy).
+    //
+    void Classify()
+    {
+        bool lower = true, upper = true;
+        changedCount_ = 0;
+        for (cardinal b = 0; b < 256; b++) {
+            const char ch = char(b);
+            lower = lower && (map_[b] == ToLowerAlpha(ch));
+            upper = upper && (map_[b] == ToUpperAlpha(ch));
+            if (map_[b] != ch && changedCount_ < kMaxSparse + 1)
+                changed_[changedCount_++] = ch;
+        }
+
+        if (changedCount_ == 0)               kind_ = KindIdentity;
+        else if (lower)                       kind_ = KindLowercase;
+        else if (upper)                       kind_ = KindUppercase;
+        else if (changedCount_ <= kMaxSparse) kind_ = KindSparse;
+        else                                  kind_ = KindTable;
+    }
+
+    char map_[256];                     // odwzorowanie bajt wejsciowy -> bajt wynikowy
+    CharSet deleted_;                   // bajty wejsciowe usuwane z wyniku
+    Kind kind_;                         // rodzaj odwzorowania (wybor jadra)
+    char changed_[kMaxSparse + 1];      // bajty zmieniane przez odwzorowanie (dla KindSparse)
+    cardinal changedCount_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana w tekscie znakow <from> na odpowiadajace im znaki <to> (jak tr, modyfikacja in-place).
+//
+inline void TranslateCharsInPlace(string& str, const char* from, const char* to)
+{
+    CharTranslator(from, to).TranslateInPlace(str);
+}
+
+
+} // namespace cans
+
+
+#endif // CA_CHARTRANSLATOR_H
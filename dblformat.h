@@ -0,0 +1,546 @@
+#ifndef CA_DBLFORMAT_H
+#define CA_DBLFORMAT_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memcpy(), memset()
+//   <stdint.h>      -> uint32_t, uint64_t
+//
+// Platforma
+//   <intrin.h>      -> _umul128() (MSVC x64)
+//
+// Repository
+//   "numutils.h"         -> cardinal, ClampInt()
+//   "intformat.h"        -> UInt64ToChars(), UIntToChars(), BitLength64(), kDigitPairs,
+//                           kPowersOf10
+//   "dblformattables.h"  -> kDblPow5Split, kDblPow5InvSplit, kDblPow5Bits, kDblPow5InvBits
+//
+
+#include <cstring>
+#include <stdint.h>
+
+#include "numutils.h"
+#include "intformat.h"
+#include "dblformattables.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Formatowanie liczb rzeczywistych (najkrotszy zapis round-trip)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Konwersja double na najkrotszy tekst dziesietny, ktory po wczytaniu (StrToDbl / strtod)
+//   daje dokladnie te sama wartosc, np. 0.1 -> "0.1" (zamiast "0.10000000000000001").
+//   Bez snprintf() i bez zaleznosci od ustawien lokalnych (separatorem jest zawsze kropka).
+//
+// Zakres odpowiedzialnosci:
+// - Wyznaczenie najkrotszej mantysy dziesietnej algorytmem Ryu (U. Adams, 2018): granice
+//   przedzialu wartosci zaokraglanych do danej liczby mnozone sa przez 125-bitowe przyblizenia
+//   poteg 5 (dblformattables.h), po czym usuwane sa zbedne cyfry. Sposrod najkrotszych zapisow
+//   wybierany jest najblizszy wartosci dokladnej (remis - cyfra parzysta).
+// - Zapis wyniku w notacji jak "%g": wykladnicza, gdy wykladnik dziesietny < -4 lub >= 17,
+//   w przeciwnym razie zwykla (bez zbednych zer i bez kropki dla liczb calkowitych).
+//   Wartosci specjalne: "nan", "-nan", "inf", "-inf" (jak glibc), zero ze znakiem: "0", "-0".
+//
+
+const cardinal kDblCharsMax = 32;   // bufor mieszczacy kazdy wynik DblToChars()
+
+
+//-------------------------------------------------------------------------------------------------
+// Liczba rzeczywista w postaci dziesietnej: mantissa * 10^exponent
+//
+struct TDecimalDbl
+{
+    uint64_t mantissa;
+    int exponent;
+};
+
+
+#if defined(__SIZEOF_INT128__)
+// Natywna liczba 128-bit (GCC / Clang); __extension__ - bez ostrzezen -Wpedantic
+__extension__ typedef unsigned __int128 UInt128;
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: iloczyn 64 x 64 -> 128 bitow (zwraca mlodsze slowo, starsze przez <hi>).
+//
+inline uint64_t MulWide64(uint64_t a, uint64_t b, uint64_t& hi)
+{
+#if defined(__SIZEOF_INT128__)
+    const UInt128 p = static_cast<UInt128>(a) * b;
+    hi = static_cast<uint64_t>(p >> 64);
+    return static_cast<uint64_t>(p);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, &hi);
+#else
+    // Iloczyny czesciowe polowek 32-bit
+    const uint64_t aLo = a & 0xFFFFFFFFULL, aHi = a >> 32;
+    const uint64_t bLo = b & 0xFFFFFFFFULL, bHi = b >> 32;
+    const uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL);
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (ll & 0xFFFFFFFFULL);
+#endif
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: (m * mul) >> j dla 125-bitowego mnoznika <mul> = { mlodsze, starsze }, 64 < j < 128.
+//
+inline uint64_t MulShift125(uint64_t m, const uint64_t* mul, int j)
+{
+    uint64_t hi0, hi1;
+    MulWide64(m, mul[0], hi0);
+    const uint64_t lo1 = MulWide64(m, mul[1], hi1);
+    // Suma (m * mul[0]) >> 64 oraz m * mul[1], z przeniesieniem do starszego slowa
+    const uint64_t sum = hi0 + lo1;
+    hi1 += (sum < hi0);
+    const int shift = j - 64;
+    return (hi1 << (64 - shift)) | (sum >> shift);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpery: logarytmy calkowite poteg 2 i 5 (przyblizenia stalymi - dokladne w zakresie double)
+//
+inline int Pow5Bits(int e)     { return static_cast<int>((static_cast<uint32_t>(e) * 1217359) >> 19) + 1; }
+inline int Log10Pow2(int e)    { return static_cast<int>((static_cast<uint32_t>(e) * 78913) >> 18); }
+inline int Log10Pow5(int e)    { return static_cast<int>((static_cast<uint32_t>(e) * 732923) >> 20); }
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpery: podzielnosc przez potege 5 / potege 2
+//
+inline bool IsMultipleOfPow5(uint64_t v, int p)
+{
+    int k = 0;
+    while (v % 5 == 0) { v /= 5; k++; }
+    return k >= p;
+}
+
+inline bool IsMultipleOfPow2(uint64_t v, int p)
+{
+    return (v & ((1ULL << p) - 1)) == 0;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Najkrotsza reprezentacja dziesietna skonczonej, niezerowej wartosci double o polach
+// <ieeeMantissa> (52 bity) i <ieeeExponent> (11 bitow) - algorytm Ryu.
+//
+inline TDecimalDbl ShortestDecimal(uint64_t ieeeMantissa, uint32_t ieeeExponent)
+{
+    const int kMantissaBits = 52;
+    const int kBias = 1023;
+
+    // Krok 1: wartosc jako m2 * 2^e2 (z dwoma dodatkowymi bitami na granice przedzialu)
+    int e2;
+    uint64_t m2;
+    if (ieeeExponent == 0) {
+        e2 = 1 - kBias - kMantissaBits - 2;
+        m2 = ieeeMantissa;
+    }
+    else {
+        e2 = static_cast<int>(ieeeExponent) - kBias - kMantissaBits - 2;
+        m2 = (1ULL << kMantissaBits) | ieeeMantissa;
+    }
+    const bool acceptBounds = (m2 & 1) == 0;
+
+    // Krok 2: przedzial wartosci zaokraglanych do danej liczby: [4*m2 - 1 - mmShift, 4*m2 + 2]
+    const uint64_t mv = 4 * m2;
+    const uint32_t mmShift = (ieeeMantissa != 0 || ieeeExponent <= 1) ? 1 : 0;
+
+    // Krok 3: przejscie do podstawy 10 (vr - wartosc, vp / vm - gorna / dolna granica)
+    uint64_t vr, vp, vm;
+    int e10;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+    if (e2 >= 0) {
+        const int q = Log10Pow2(e2) - (e2 > 3);
+        e10 = q;
+        const int k = kDblPow5InvBits + Pow5Bits(q) - 1;
+        const int i = -e2 + q + k;
+        vr = MulShift125(4 * m2, kDblPow5InvSplit[q], i);
+        vp = MulShift125(4 * m2 + 2, kDblPow5InvSplit[q], i);
+        vm = MulShift125(4 * m2 - 1 - mmShift, kDblPow5InvSplit[q], i);
+        if (q <= 21) {
+            // Co najwyzej jedna z wartosci mv, mp, mm moze byc wielokrotnoscia 5
+            if (mv % 5 == 0)
+                vrIsTrailingZeros = IsMultipleOfPow5(mv, q);
+            else if (acceptBounds)
+                vmIsTrailingZeros = IsMultipleOfPow5(mv - 1 - mmShift, q);
+            else
+                vp -= IsMultipleOfPow5(mv + 2, q);
+        }
+    }
+    else {
+        const int q = Log10Pow5(-e2) - (-e2 > 1);
+        e10 = q + e2;
+        const int i = -e2 - q;
+        const int k = Pow5Bits(i) - kDblPow5Bits;
+        const int j = q - k;
+        vr = MulShift125(4 * m2, kDblPow5Split[i], j);
+        vp = MulShift125(4 * m2 + 2, kDblPow5Split[i], j);
+        vm = MulShift125(4 * m2 - 1 - mmShift, kDblPow5Split[i], j);
+        if (q <= 1) {
+            // mv = 4 * m2 ma zawsze co najmniej dwa zerowe bity na koncu
+            vrIsTrailingZeros = true;
+            if (acceptBounds)
+                vmIsTrailingZeros = (mmShift == 1);
+            else
+                --vp;
+        }
+        else if (q < 63) {
+            vrIsTrailingZeros = IsMultipleOfPow2(mv, q);
+        }
+    }
+
+    // Krok 4: usuwanie cyfr, dopoki granice przedzialu pozostaja rozne
+    int removed = 0;
+    uint64_t output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+        // Przypadek ogolny (rzadki): sledzenie zer konczacych wartosc dokladna
+        unsigned lastRemovedDigit = 0;
+        for (;;) {
+            if (vp / 10 <= vm / 10) break;
+            vmIsTrailingZeros &= (vm % 10 == 0);
+            vrIsTrailingZeros &= (lastRemovedDigit == 0);
+            lastRemovedDigit = static_cast<unsigned>(vr % 10);
+            vr /= 10; vp /= 10; vm /= 10;
+            ++removed;
+        }
+        if (vmIsTrailingZeros) {
+            while (vm % 10 == 0) {
+                vrIsTrailingZeros &= (lastRemovedDigit == 0);
+                lastRemovedDigit = static_cast<unsigned>(vr % 10);
+                vr /= 10; vp /= 10; vm /= 10;
+                ++removed;
+            }
+        }
+        // Remis (dokladnie ...50..0) - zaokraglenie do cyfry parzystej
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0)
+            lastRemovedDigit = 4;
+        output = vr + (((vr == vm) && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    }
+    else {
+        // Przypadek typowy: bez sledzenia zer, usuwanie najpierw po dwie cyfry
+        bool roundUp = false;
+        if (vp / 100 > vm / 100) {
+            roundUp = (vr % 100) >= 50;
+            vr /= 100; vp /= 100; vm /= 100;
+            removed += 2;
+        }
+        for (;;) {
+            if (vp / 10 <= vm / 10) break;
+            roundUp = (vr % 10) >= 5;
+            vr /= 10; vp /= 10; vm /= 10;
+            ++removed;
+        }
+        output = vr + ((vr == vm) || roundUp);
+    }
+
+    TDecimalDbl d;
+    d.mantissa = output;
+    d.exponent = e10 + removed;
+    return d;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: zapis tekstu (bez terminatora), zwraca wskaznik za ostatnim znakiem.
+//
+inline char* CopyChars(char* out, const char* text)
+{
+    while (*text) *out++ = *text++;
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis liczby mantissa * 10^exponent w notacji jak "%g" (wykladnicza dla wykladnika dziesietnego
+// < -4 lub >= 17). Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* WriteDecimalGeneral(uint64_t mantissa, int exponent, char* out)
+{
+    char digits[kIntCharsMax];
+    const int n = static_cast<int>(UInt64ToChars(mantissa, digits) - digits);
+    // Wykladnik w zapisie naukowym (d.ddd * 10^x)
+    const int x = exponent + n - 1;
+
+    if (x < -4 || x >= 17) {
+        // Notacja wykladnicza: d[.ddd]e(+|-)xx
+        *out++ = digits[0];
+        if (n > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, n - 1);
+            out += n - 1;
+        }
+        *out++ = 'e';
+        *out++ = (x < 0) ? '-' : '+';
+        const unsigned ax = static_cast<unsigned>(x < 0 ? -x : x);
+        // Co najmniej dwie cyfry wykladnika (jak printf)
+        if (ax < 10) *out++ = '0';
+        return UIntToChars(ax, out);
+    }
+
+    if (x >= n - 1) {
+        // Liczba calkowita: cyfry i zera koncowe
+        memcpy(out, digits, n);
+        out += n;
+        for (int i = n - 1; i < x; i++) *out++ = '0';
+        return out;
+    }
+
+    if (x >= 0) {
+        // Kropka wewnatrz ciagu cyfr
+        memcpy(out, digits, x + 1);
+        out += x + 1;
+        *out++ = '.';
+        memcpy(out, digits + x + 1, n - x - 1);
+        return out + (n - x - 1);
+    }
+
+    // Wartosc < 1: "0." i zera wiodace
+    *out++ = '0';
+    *out++ = '.';
+    for (int i = x + 1; i < 0; i++) *out++ = '0';
+    memcpy(out, digits, n);
+    return out + n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby rzeczywistej na najkrotszy tekst round-trip (zapis do bufora wywolujacego,
+// bez terminatora '\0'; bufor musi pomiescic kDblCharsMax znakow). Zwraca wskaznik za ostatnim
+// znakiem.
+//
+inline char* DblToChars(double value, char* out)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const bool sign = (bits >> 63) != 0;
+    const uint64_t ieeeMantissa = bits & ((1ULL << 52) - 1);
+    const uint32_t ieeeExponent = static_cast<uint32_t>((bits >> 52) & 0x7FF);
+
+    // Wartosci specjalne
+    if (ieeeExponent == 0x7FF) {
+        if (ieeeMantissa != 0) return CopyChars(out, sign ? "-nan" : "nan");
+        return CopyChars(out, sign ? "-inf" : "inf");
+    }
+    if (sign) *out++ = '-';
+    if (ieeeExponent == 0 && ieeeMantissa == 0) {
+        *out++ = '0';
+        return out;
+    }
+
+    const TDecimalDbl d = ShortestDecimal(ieeeMantissa, ieeeExponent);
+    return WriteDecimalGeneral(d.mantissa, d.exponent, out);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Formatowanie liczb rzeczywistych (zapis staloprzecinkowy)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Konwersja double na tekst z zadana liczba miejsc dziesietnych (jak "%.*f"), bez snprintf()
+//   i bez zaleznosci od ustawien lokalnych (separatorem jest zawsze kropka).
+//
+// Zakres odpowiedzialnosci:
+// - Zaokraglenie wartosci dokladnej (a nie jej przyblizenia dziesietnego) do <decimals> miejsc:
+//   polowki do parzystej (DblHalfEven - wynik identyczny z printf) lub od zera (DblHalfUp).
+// - Liczba miejsc dziesietnych ograniczona do przedzialu [0, kDblFixedDecimalsMax].
+//
+// Uwagi projektowe:
+// * Wartosc m * 2^e (m - 53-bitowa mantysa) rozdzielana jest na czesc calkowita i ulamek
+//   mf / 2^k. Cyfry ulamka to mf * 5^d / 2^(k - d) - iloczyn liczony dokladnie w 128 bitach,
+//   a bity odciete przesunieciem rozstrzygaja zaokraglenie (bit polowki i bity ponizej niego).
+// * Czesci calkowite >= 2^64 (wylacznie wartosci calkowite) zapisywane sa przez dzielenie
+//   dlugiej liczby binarnej (slowa 32-bit) przez 10^9.
+// * Wartosci specjalne: "nan", "-nan", "inf", "-inf" (jak glibc). Znak zachowywany jest takze
+//   dla zera i wynikow zaokraglonych do zera (np. "-0.00"), jak w printf.
+//
+
+const int kDblFixedDecimalsMax = 16;                                     // maks. liczba miejsc
+const cardinal kDblFixedCharsMax = 1 + 309 + 1 + kDblFixedDecimalsMax;   // "-", cyfry, ".", ulamek
+
+
+// Sposob zaokraglania polowek w DblToCharsFixed()
+enum DblRounding
+{
+    DblHalfEven,    // polowka do cyfry parzystej (jak printf)
+    DblHalfUp       // polowka od zera (zaokraglenie "handlowe")
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: zapis dokladnie <n> cyfr wartosci (z zerami wiodacymi) od <out>.
+// Zwraca wskaznik za ostatnia cyfra.
+//
+inline char* WriteDigitsPadded(uint64_t v, cardinal n, char* out)
+{
+    char* p = out + n;
+    while (p - out >= 2) {
+        p -= 2;
+        memcpy(p, kDigitPairs + (v % 100) * 2, 2);
+        v /= 100;
+    }
+    if (p != out) *--p = char('0' + v % 10);
+    return out + n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: zapis cyfr liczby calkowitej m * 2^e (e > 0, wynik >= 2^64). Zwraca wskaznik za
+// ostatnia cyfra.
+//
+inline char* WriteBigInteger(uint64_t m, int e, char* out)
+{
+    // Liczba w slowach 32-bit (od najmlodszego): m < 2^53, e <= 971 - co najwyzej 34 slowa
+    uint32_t words[34] = { 0 };
+    const int base = e / 32;
+    const int shift = e % 32;
+    const uint64_t lo = m << shift;
+    const uint64_t hi = shift ? (m >> (64 - shift)) : 0;
+    words[base] = static_cast<uint32_t>(lo);
+    words[base + 1] = static_cast<uint32_t>(lo >> 32);
+    words[base + 2] = static_cast<uint32_t>(hi);
+    int count = base + 3;
+
+    // Porcje po 9 cyfr (od najmlodszej) - reszty z dzielenia calej liczby przez 10^9
+    uint32_t chunks[36];
+    int chunkCount = 0;
+    while (count > 0) {
+        uint64_t rem = 0;
+        for (int i = count - 1; i >= 0; i--) {
+            const uint64_t cur = (rem << 32) | words[i];
+            words[i] = static_cast<uint32_t>(cur / 1000000000);
+            rem = cur % 1000000000;
+        }
+        chunks[chunkCount++] = static_cast<uint32_t>(rem);
+        while (count > 0 && words[count - 1] == 0) count--;
+    }
+
+    // Porcja najstarsza bez zer wiodacych, pozostale - dokladnie 9 cyfr
+    out = UIntToChars(chunks[chunkCount - 1], out);
+    for (int i = chunkCount - 2; i >= 0; i--)
+        out = WriteDigitsPadded(chunks[i], 9, out);
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby rzeczywistej na tekst z <decimals> miejscami dziesietnymi (zapis do bufora
+// wywolujacego, bez terminatora '\0'; bufor musi pomiescic kDblFixedCharsMax znakow).
+// Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* DblToCharsFixed(double value, int decimals, char* out, DblRounding rounding = DblHalfEven)
+{
+    const int d = ClampInt(decimals, 0, kDblFixedDecimalsMax);
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const bool sign = (bits >> 63) != 0;
+    const uint64_t ieeeMantissa = bits & ((1ULL << 52) - 1);
+    const uint32_t ieeeExponent = static_cast<uint32_t>((bits >> 52) & 0x7FF);
+
+    // Wartosci specjalne
+    if (ieeeExponent == 0x7FF) {
+        if (ieeeMantissa != 0) return CopyChars(out, sign ? "-nan" : "nan");
+        return CopyChars(out, sign ? "-inf" : "inf");
+    }
+    if (sign) *out++ = '-';
+
+    // Wartosc = m * 2^e
+    const uint64_t m = (ieeeExponent == 0) ? ieeeMantissa : (ieeeMantissa | (1ULL << 52));
+    const int e = ((ieeeExponent == 0) ? 1 : static_cast<int>(ieeeExponent)) - 1075;
+
+    // Liczby calkowite >= 2^64 - dlugie dzielenie, ulamek zerowy
+    if (e > 0 && static_cast<int>(BitLength64(m)) + e > 64) {
+        out = WriteBigInteger(m, e, out);
+        if (d > 0) {
+            *out++ = '.';
+            memset(out, '0', d);
+            out += d;
+        }
+        return out;
+    }
+
+    uint64_t intPart = 0;
+    uint64_t fraction = 0;   // <d> cyfr ulamka jako liczba calkowita
+    if (e >= 0) {
+        intPart = m << e;
+    }
+    else {
+        // Czesc calkowita i ulamek mf / 2^k
+        const int k = -e;
+        uint64_t mf = m;
+        if (k < 64) {
+            intPart = m >> k;
+            mf = m & ((1ULL << k) - 1);
+        }
+
+        // Cyfry ulamka: mf * 10^d / 2^k = (mf * 5^d) >> (k - d), iloczyn 128-bit [hi:lo]
+        uint64_t hi;
+        const uint64_t lo = MulWide64(mf, kPowersOf10[d] >> d, hi);
+        const int s = k - d;
+        bool roundBit = false;   // bit o wadze 1/2 ostatniej cyfry
+        bool sticky = false;     // bity ponizej bitu polowki
+        if (s <= 0) {
+            // Ulamek dokladny (mf < 2^k <= 2^d, wiec iloczyn miesci sie w 64 bitach)
+            fraction = lo << -s;
+        }
+        else if (s < 64) {
+            fraction = (lo >> s) | (hi << (64 - s));
+            roundBit = ((lo >> (s - 1)) & 1) != 0;
+            sticky = (lo & ((1ULL << (s - 1)) - 1)) != 0;
+        }
+        else if (s < 128) {
+            fraction = hi >> (s - 64);
+            if (s == 64) {
+                roundBit = (lo >> 63) != 0;
+                sticky = (lo & ~(1ULL << 63)) != 0;
+            }
+            else {
+                roundBit = ((hi >> (s - 65)) & 1) != 0;
+                sticky = (lo != 0) || (hi & ((1ULL << (s - 65)) - 1)) != 0;
+            }
+        }
+        // Dla s >= 128 iloczyn (< 2^91) jest ponizej polowki - wynik zerowy
+
+        // Zaokraglenie: polowka w gore (od zera) lub do parzystej ostatniej cyfry
+        const uint64_t last = (d > 0) ? fraction : intPart;
+        if (roundBit && (rounding == DblHalfUp || sticky || (last & 1))) {
+            if (++fraction == kPowersOf10[d]) {
+                fraction = 0;
+                intPart++;
+            }
+        }
+    }
+
+    out = UInt64ToChars(intPart, out);
+    if (d > 0) {
+        *out++ = '.';
+        out = WriteDigitsPadded(fraction, d, out);
+    }
+    return out;
+}
+
+
+} // namespace cans
+
+
+#endif // CA_DBLFORMAT_H
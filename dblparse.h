@@ -0,0 +1,290 @@
+#ifndef CA_DBLPARSE_H
+#define CA_DBLPARSE_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cerrno>        -> errno, ERANGE
+//   <cfloat>        -> DBL_MAX, FLT_EVAL_METHOD
+//   <cstdlib>       -> strtod()
+//   <cstring>       -> memcpy()
+//   <stdint.h>      -> uint64_t
+//   <string>        -> std::string
+//
+// Repository
+//   "numutils.h"         -> cardinal, IsDigitSign(), IsExponentMarker(), TParseResult,
+//                           MakeParseResult(), IsParsedWhole()
+//   "strutils.h"         -> IsAsciiDigit()
+//   "intformat.h"        -> BitLength64(), IntToChars()
+//   "dblformat.h"        -> MulWide64()
+//   "dblparsetables.h"   -> kPow5Table128, kPow5MinExp10, kPow5MaxExp10
+//
+
+#include <cerrno>
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+
+#include "numutils.h"
+#include "strutils.h"
+#include "intformat.h"
+#include "dblformat.h"
+#include "dblparsetables.h"
+
+
+
+
+namespace cans
+{
+    using std::string;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Wczytywanie liczb rzeczywistych
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Konwersja tekstu dziesietnego [+-]?(digits)?(.digits)?([eE][+-]?digits)? na double,
+//   z wynikiem poprawnie zaokraglonym (identycznym jak strtod), bez zaleznosci od ustawien
+//   lokalnych i bez wymogu terminatora '\0'. Separator dziesietny moze byc kropka lub przecinkiem.
+//
+// Zakres odpowiedzialnosci:
+// - Sciezka szybka: do 19 cyfr znaczacych w mantysie 64-bit oraz wykladnik dziesietny;
+//   (1) dla mantys <= 2^53 i wykladnikow |q| <= 22 - jedno dokladne mnozenie / dzielenie double
+//   (Clinger), (2) w pozostalych przypadkach algorytm Eisel-Lemire - iloczyn mantysy
+//   i 128-bitowego przyblizenia 5^q (dblparsetables.h).
+// - Sciezka dokladna (rzadka): strtod() na znormalizowanym zapisie "cyfry" "e" "wykladnik" -
+//   gdy mantysa ma wiecej niz 19 cyfr i obciecie moze zmienic wynik, gdy Eisel-Lemire nie
+//   rozstrzyga zaokraglenia, oraz gdy wynik wykracza poza zakres liczb znormalizowanych.
+// - ScanDecimalDbl() odczytuje liczbe z poczatku zakresu [first, last) i zwraca TParseResult
+//   (koniec liczby, status: niepoprawna / poza zakresem); ParseDecimalDbl() wymaga, aby caly
+//   tekst byl liczba.
+//
+// Uwagi projektowe:
+// * Wynik spoza zakresu jest bledem, tak jak sygnalizuje to strtod() przez ERANGE: nadmiar
+//   (inf) oraz niedomiar - takze wyniki subnormalne (glibc zglasza ERANGE dla kazdego wyniku
+//   subnormalnego niezerowego tekstu, a dla wyniku DBL_MIN - gdy wartosc dokladna po
+//   zaokragleniu z nieograniczonym wykladnikiem bylaby mniejsza). Wyniki graniczne przechodza
+//   zatem zawsze przez strtod(), wiec klasyfikacja bledow jest identyczna z biblioteczna.
+// * Zapis znormalizowany dla strtod() nie zawiera separatora dziesietnego, wiec nie zalezy
+//   od ustawien lokalnych. Tylko ta sciezka korzysta z errno (strtod) - sciezki szybkie nie.
+//
+
+//-------------------------------------------------------------------------------------------------
+// Helper: sciezka dokladna - strtod() na zapisie <digits>e<exp10> (bez separatora dziesietnego).
+// Zwraca false, gdy wynik wykracza poza zakres liczb znormalizowanych double.
+//
+inline bool ParseDblExact(bool negative, const char* digits, cardinal n, long exp10, double& out)
+{
+    string buf;
+    buf.reserve(n + 24);
+    if (negative) buf += '-';
+    buf.append(digits, n);
+    buf += 'e';
+
+    char e[kIntCharsMax];
+    // Wykladnik przyciety do zakresu int (poza nim wynik jest i tak zerem lub nieskonczonoscia)
+    const long kLimit = 100000000L;
+    const int clipped = static_cast<int>(exp10 < -kLimit ? -kLimit : (exp10 > kLimit ? kLimit : exp10));
+    buf.append(e, IntToChars(clipped, e));
+
+    char* end = NULL;
+    errno = 0;
+    const double v = strtod(buf.c_str(), &end);
+    // Odrzucenie nadmiaru / niedomiaru (ERANGE) oraz nieskonczonosci (biblioteki bez ERANGE)
+    if (errno == ERANGE || v > DBL_MAX || v < -DBL_MAX) return false;
+
+    out = v;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: algorytm Eisel-Lemire dla w * 10^q (w != 0, bez obciecia cyfr).
+// Zwraca false, gdy wynik nie jest rozstrzygniety lub nie jest liczba znormalizowana > DBL_MIN
+// (wtedy nalezy uzyc sciezki dokladnej).
+//
+inline bool EiselLemire(uint64_t w, int q, bool negative, double& out)
+{
+    if (q < kPow5MinExp10 || q > kPow5MaxExp10) return false;
+
+    // Normalizacja mantysy (najstarszy bit ustawiony)
+    const int lz = 64 - static_cast<int>(BitLength64(w));
+    w <<= lz;
+
+    // Iloczyn z przyblizeniem 5^q: starsze slowo, a gdy bity ponizej precyzji wyniku (55 bitow)
+    // sa same jedynki - doprecyzowanie mlodszym slowem przyblizenia
+    const uint64_t* pow5 = kPow5Table128[q - kPow5MinExp10];
+    uint64_t hi;
+    uint64_t lo = MulWide64(w, pow5[0], hi);
+    const uint64_t kPrecisionMask = 0xFFFFFFFFFFFFFFFFULL >> 55;
+    if ((hi & kPrecisionMask) == kPrecisionMask) {
+        uint64_t hi2;
+        MulWide64(w, pow5[1], hi2);
+        lo += hi2;
+        if (hi2 > lo) hi++;
+        // Przyblizenie nadal nie rozstrzyga zaokraglenia
+        if (lo == 0xFFFFFFFFFFFFFFFFULL && (q < -27 || q > 55)) return false;
+    }
+
+    // 54 bity mantysy (bit zaokraglenia na koncu) i wykladnik binarny
+    const int upperBit = static_cast<int>(hi >> 63);
+    const int shift = upperBit + 64 - 52 - 3;
+    uint64_t mantissa = hi >> shift;
+    int power2 = static_cast<int>((((152170 + 65536) * q) >> 16) + 63) + upperBit - lz + 1023;
+
+    // Wynik subnormalny lub zero - poza sciezka szybka
+    if (power2 <= 0) return false;
+
+    // Remis dokladnie pomiedzy dwiema liczbami (mozliwy tylko dla malych q) - do parzystej
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == hi)
+        mantissa &= ~1ULL;
+    // Zaokraglenie (w gore, o ile nie skorygowano powyzej)
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << 52)) {
+        mantissa = (1ULL << 52);
+        power2++;
+    }
+    mantissa &= ~(1ULL << 52);
+
+    // Nadmiar oraz wynik rowny DBL_MIN (klasyfikacja ERANGE jak w strtod) - poza sciezka szybka
+    if (power2 >= 0x7FF) return false;
+    if (power2 == 1 && mantissa == 0) return false;
+
+    const uint64_t bits = mantissa | (static_cast<uint64_t>(power2) << 52) |
+                          (static_cast<uint64_t>(negative) << 63);
+    memcpy(&out, &bits, sizeof(out));
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby rzeczywistej [+-]?(digits)?(<decimalPoint>digits)?([eE][+-]?digits)? (co najmniej
+// jedna cyfra mantysy) z poczatku zakresu [first, last). Marker wykladnika bez cyfr nie nalezy
+// do liczby (odczyt konczy sie przed nim).
+// Zwraca ParseInvalid, gdy zakres nie zaczyna sie od liczby, oraz ParseOutOfRange, gdy wynik
+// wykracza poza zakres liczb znormalizowanych double.
+//
+inline TParseResult ScanDecimalDbl(const char* first, const char* last, double& out, char decimalPoint = '.')
+{
+    const char* p = first;
+    const char* const end = last;
+
+    // Znak
+    bool negative = false;
+    if (p < end && IsDigitSign(*p)) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    // Mantysa: pierwsze 19 cyfr znaczacych w slowie 64-bit, dalsze tylko zliczane
+    const char* digitsBegin = p;
+    uint64_t w = 0;
+    cardinal significant = 0;   // cyfry znaczace (bez zer wiodacych)
+    long dropped = 0;           // cyfry znaczace pominiete po 19. (wplywaja na wykladnik)
+    long fraction = 0;          // cyfry znaczace po separatorze uwzglednione w <w>
+    bool truncated = false;     // wsrod pominietych cyfr jest niezerowa
+    cardinal digits = 0;
+
+    for (; p < end && IsAsciiDigit(*p); p++, digits++) {
+        const unsigned d = static_cast<unsigned>(*p - '0');
+        if (significant == 0 && d == 0) continue;
+        if (significant < 19) { w = w * 10 + d; significant++; }
+        else { dropped++; truncated |= (d != 0); }
+    }
+    const char* pointPos = NULL;
+    if (p < end && *p == decimalPoint) {
+        pointPos = p++;
+        for (; p < end && IsAsciiDigit(*p); p++, digits++) {
+            const unsigned d = static_cast<unsigned>(*p - '0');
+            if (significant == 0 && d == 0) { fraction++; continue; }
+            if (significant < 19) { w = w * 10 + d; significant++; fraction++; }
+            else { truncated |= (d != 0); }
+        }
+    }
+    // Mantysa musi zawierac co najmniej jedna cyfre
+    if (digits == 0) return MakeParseResult(first, ParseInvalid);
+
+    // Wykladnik (nasycany - wartosci skrajne daja i tak zero lub nadmiar)
+    long exp10 = 0;
+    if (p < end && IsExponentMarker(*p)) {
+        const char* e = p + 1;
+        bool expNegative = false;
+        if (e < end && IsDigitSign(*e)) {
+            expNegative = (*e == '-');
+            e++;
+        }
+        if (e < end && IsAsciiDigit(*e)) {
+            for (; e < end && IsAsciiDigit(*e); e++) {
+                if (exp10 < 100000000L) exp10 = exp10 * 10 + (*e - '0');
+            }
+            if (expNegative) exp10 = -exp10;
+            p = e;
+        }
+    }
+
+    // Zero (same zera w mantysie)
+    if (w == 0) {
+        out = negative ? -0.0 : 0.0;
+        return MakeParseResult(p, ParseOk);
+    }
+
+    const long q = exp10 + dropped - fraction;
+
+    if (!truncated && q >= -342 && q <= 308)
+    {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+        // Clinger: mantysa i 10^|q| dokladne w double - jedno poprawnie zaokraglone dzialanie
+        static const double kExact10[23] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        if (w <= (1ULL << 53) && q >= -22 && q <= 22) {
+            double v = static_cast<double>(w);
+            v = (q < 0) ? v / kExact10[-q] : v * kExact10[q];
+            out = negative ? -v : v;
+            return MakeParseResult(p, ParseOk);
+        }
+#endif
+        if (EiselLemire(w, static_cast<int>(q), negative, out)) return MakeParseResult(p, ParseOk);
+    }
+
+    // Sciezka dokladna: wszystkie cyfry mantysy (bez separatora) i wykladnik skorygowany
+    // o liczbe cyfr po separatorze
+    string mantissa;
+    mantissa.reserve(digits);
+    long fractionDigits = 0;
+    for (const char* c = digitsBegin; c < digitsBegin + digits + (pointPos ? 1 : 0); c++) {
+        if (c == pointPos) continue;
+        mantissa += *c;
+        if (pointPos && c > pointPos) fractionDigits++;
+    }
+    if (!ParseDblExact(negative, mantissa.data(), mantissa.size(), exp10 - fractionDigits, out))
+        return MakeParseResult(p, ParseOutOfRange);
+    return MakeParseResult(p, ParseOk);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja tekstu (<n> znakow <p>, bez wymogu terminatora) na liczbe rzeczywista - jak
+// ScanDecimalDbl(), lecz caly tekst musi byc liczba. Zwraca false, gdy tekst jest niepoprawny
+// lub wynik wykracza poza zakres (<out> pozostaje wtedy bez zmian).
+//
+inline bool ParseDecimalDbl(const char* p, cardinal n, double& out, char decimalPoint = '.')
+{
+    double v;
+    if (!IsParsedWhole(ScanDecimalDbl(p, p + n, v, decimalPoint), p + n)) return false;
+
+    out = v;
+    return true;
+}
+
+
+} // namespace cans
+
+
+#endif // CA_DBLPARSE_H
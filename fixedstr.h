@@ -0,0 +1,124 @@
+#ifndef CA_FIXEDSTR_H
+#define CA_FIXEDSTR_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <string>        -> std::string
+//
+// Repository
+//   "numutils.h"    -> cardinal, CA_CONSTEXPR
+//   "strview.h"     -> StrView, CA_HAS_STD_STRING_VIEW
+//
+
+#include <string>
+
+#include "numutils.h"
+#include "strview.h"
+
+#if defined(CA_HAS_STD_STRING_VIEW)
+#define CA_CONSTEXPR17 constexpr
+#else
+#define CA_CONSTEXPR17 inline
+#endif
+
+
+
+
+namespace cans
+{
+    using std::string;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Teksty o stalej pojemnosci wyznaczane w czasie kompilacji
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Wynik konwersji liczba -> tekst (etykiety rzymskie, literowe, liczby dziesietne), ktory moze
+//   byc stala czasu kompilacji: statyczne tablice etykiet trafiaja gotowe do pliku binarnego,
+//   bez budowania ich przy starcie programu.
+//
+// Zakres odpowiedzialnosci:
+// - FixedStr<N>: bufor N znakow i terminatora '\0' oraz dlugosc tekstu (<= N); kopiowalny
+//   agregat bez alokacji pamieci.
+// - MakeFixedStr<N>(gen): wypelnienie bufora znakami generatora - obiektu z metodami
+//   Size() (dlugosc tekstu) i At(i) (znak nr i, '\0' poza tekstem), obie constexpr.
+//
+// Uwagi projektowe:
+// * Postac C++11: kazdy znak wyliczany jest niezaleznie (At(i)), a bufor inicjowany przez
+//   rozwiniecie pakietu indeksow 0..N-1 - bez petli i bez modyfikacji obiektu w constexpr.
+// * W C++17 View() jest constexpr (StrView to wtedy std::string_view).
+// * Konwersje wywolane w czasie wykonania sa poprawne, lecz wolniejsze niz XxxToChars() -
+//   sluza do stalych.
+//
+
+//-------------------------------------------------------------------------------------------------
+// Helper: ciag indeksow 0..N-1 jako pakiet parametrow szablonu (odpowiednik std::index_sequence
+// z C++14)
+//
+template <cardinal... I>
+struct IndexSeq
+{
+};
+
+template <cardinal N, cardinal... I>
+struct MakeIndexSeq : MakeIndexSeq<N - 1, N - 1, I...>
+{
+};
+
+template <cardinal... I>
+struct MakeIndexSeq<0, I...>
+{
+    typedef IndexSeq<I...> type;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Tekst o pojemnosci N znakow (z terminatorem '\0'), mozliwy do wyznaczenia w czasie kompilacji
+//
+template <cardinal N>
+struct FixedStr
+{
+    char chars[N + 1];   // tekst i terminator; znaki za tekstem to '\0'
+    cardinal length;     // dlugosc tekstu (<= N)
+
+    CA_CONSTEXPR cardinal size() const { return length; }
+    CA_CONSTEXPR bool empty() const { return length == 0; }
+    CA_CONSTEXPR const char* data() const { return chars; }
+    CA_CONSTEXPR const char* c_str() const { return chars; }
+    CA_CONSTEXPR char operator[](cardinal i) const { return chars[i]; }
+
+    //---------------------------------------------------------------------------------------------
+    // Widok tekstu (wazny, dopoki istnieje obiekt) i kopia jako std::string.
+    //
+    CA_CONSTEXPR17 StrView View() const { return StrView(chars, length); }
+    string Str() const { return string(chars, length); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: bufor z kolejnych znakow generatora (indeksy 0..N-1) i terminatora.
+//
+template <cardinal N, class Generator, cardinal... I>
+CA_CONSTEXPR FixedStr<N> MakeFixedStrOf(const Generator& gen, IndexSeq<I...>)
+{
+    return FixedStr<N>{ { gen.At(I)..., '\0' }, gen.Size() };
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Utworzenie tekstu o pojemnosci N ze znakow generatora <gen> (Size() <= N).
+//
+template <cardinal N, class Generator>
+CA_CONSTEXPR FixedStr<N> MakeFixedStr(const Generator& gen)
+{
+    return MakeFixedStrOf<N>(gen, typename MakeIndexSeq<N>::type());
+}
+
+
+} // namespace cans
+
+
+#endif // CA_FIXEDSTR_H
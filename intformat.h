@@ -0,0 +1,265 @@
+#ifndef CA_INTFORMAT_H
+#define CA_INTFORMAT_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memcpy()
+//   <stdint.h>      -> uint32_t, uint64_t
+//
+// Platforma
+//   <intrin.h>      -> _BitScanReverse64() (MSVC x64)
+//
+// Repository
+//   "numutils.h"    -> cardinal, CA_CONSTEXPR
+//
+
+#include <cstring>
+#include <stdint.h>
+
+#include "numutils.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Formatowanie liczb calkowitych
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Szybka konwersja liczb calkowitych (int, long long, unsigned, unsigned long long) na tekst
+//   dziesietny, bez snprintf() i bez zaleznosci od ustawien lokalnych.
+//
+// Zakres odpowiedzialnosci:
+// - Funkcje XxxToChars(value, out) zapisuja cyfry do bufora wywolujacego (bez terminatora '\0')
+//   i zwracaja wskaznik za ostatnim zapisanym znakiem. Bufor musi pomiescic kIntCharsMax znakow.
+// - IntCharsGenerator: te same cyfry wyliczane w czasie kompilacji (dla MakeFixedStr()).
+//
+// Uwagi projektowe:
+// * Liczba cyfr wyznaczana jest z dlugosci bitowej wartosci (jedno porownanie z potega 10),
+//   po czym cyfry zapisywane sa od konca parami - z tablicy 100 par "00".."99".
+// * Wartosci 64-bit mieszczace sie w 32 bitach formatowane sa arytmetyka 32-bit.
+//
+
+const cardinal kIntCharsMax = 20;   // najdluzszy wynik: "-9223372036854775808", "18446744073709551615"
+
+
+//-------------------------------------------------------------------------------------------------
+// Tablica par cyfr dziesietnych: znaki [2k, 2k+1] to zapis liczby k (00..99)
+//
+static const char kDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+
+//-------------------------------------------------------------------------------------------------
+// Tablica poteg 10 (10^0 .. 10^19)
+//
+static const uint64_t kPowersOf10[20] =
+{
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: liczba bitow znaczacych wartosci (0 dla zera).
+//
+inline cardinal BitLength64(uint64_t v)
+{
+    if (v == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+    return 64 - static_cast<cardinal>(__builtin_clzll(v));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long k;
+    _BitScanReverse64(&k, v);
+    return static_cast<cardinal>(k) + 1;
+#else
+    cardinal n = 0;
+    while (v) { v >>= 1; n++; }
+    return n;
+#endif
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Liczba cyfr dziesietnych wartosci (1 dla zera).
+//
+inline cardinal CountDecimalDigits(uint64_t v)
+{
+    // Przyblizenie log10 z dlugosci bitowej (1233 / 4096 ~ log10(2)), korygowane jednym
+    // porownaniem z potega 10
+    const cardinal t = (BitLength64(v) * 1233) >> 12;
+    return t + 1 - ((v | 1) < kPowersOf10[t]);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: zapis <n> cyfr wartosci 32-bit od konca bufora [out .. out + n).
+//
+inline void WriteDigits32(uint32_t v, char* out, cardinal n)
+{
+    char* p = out + n;
+    // Zapis par cyfr od najmniej znaczacych ...
+    while (v >= 100) {
+        const uint32_t k = (v % 100) * 2;
+        v /= 100;
+        p -= 2;
+        memcpy(p, kDigitPairs + k, 2);
+    }
+    // ... i ostatniej jednej lub dwoch cyfr
+    if (v >= 10) {
+        p -= 2;
+        memcpy(p, kDigitPairs + v * 2, 2);
+    }
+    else {
+        *--p = char('0' + v);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: zapis dokladnie <pairs> par cyfr wartosci 32-bit (z zerami wiodacymi) od <out>.
+//
+inline void WriteDigitPairs(uint32_t v, char* out, cardinal pairs)
+{
+    for (cardinal i = pairs; i > 0; i--) {
+        memcpy(out + 2 * (i - 1), kDigitPairs + (v % 100) * 2, 2);
+        v /= 100;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej bez znaku (32-bit) na tekst. Zwraca wskaznik za ostatnia cyfra.
+//
+inline char* UIntToChars(unsigned value, char* out)
+{
+    const uint32_t v = static_cast<uint32_t>(value);
+    const cardinal n = CountDecimalDigits(v);
+    WriteDigits32(v, out, n);
+    return out + n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej bez znaku (64-bit) na tekst. Zwraca wskaznik za ostatnia cyfra.
+//
+inline char* UInt64ToChars(unsigned long long value, char* out)
+{
+    uint64_t v = static_cast<uint64_t>(value);
+    const cardinal n = CountDecimalDigits(v);
+
+    // Wartosci 32-bit - arytmetyka 32-bit
+    if (v <= 0xFFFFFFFFULL) {
+        WriteDigits32(static_cast<uint32_t>(v), out, n);
+        return out + n;
+    }
+
+    char* p = out + n;
+    // Odciecie najmlodszych 8 cyfr (porcjami 10^8) az wartosc zmiesci sie w 32 bitach
+    while (v > 0xFFFFFFFFULL) {
+        const uint32_t low = static_cast<uint32_t>(v % 100000000ULL);
+        v /= 100000000ULL;
+        // Zapis porcji jako dokladnie 8 cyfr (4 pary, z zerami wiodacymi)
+        p -= 8;
+        WriteDigitPairs(low, p, 4);
+    }
+    WriteDigits32(static_cast<uint32_t>(v), out, static_cast<cardinal>(p - out));
+    return out + n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej (int) na tekst. Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* IntToChars(int value, char* out)
+{
+    // Modul liczony w arytmetyce bez znaku (poprawny takze dla INT_MIN)
+    unsigned u = static_cast<unsigned>(value);
+    if (value < 0) {
+        *out++ = '-';
+        u = 0u - u;
+    }
+    return UIntToChars(u, out);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej (long long) na tekst. Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* Int64ToChars(long long value, char* out)
+{
+    unsigned long long u = static_cast<unsigned long long>(value);
+    if (value < 0) {
+        *out++ = '-';
+        u = 0ULL - u;
+    }
+    return UInt64ToChars(u, out);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: liczba cyfr dziesietnych wartosci (postac constexpr C++11).
+//
+CA_CONSTEXPR cardinal DecimalLength(unsigned long long v)
+{
+    return (v < 10) ? 1 : 1 + DecimalLength(v / 10);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: cyfra dziesietna nr <k> liczac od najmlodszej (postac constexpr C++11).
+//
+CA_CONSTEXPR char DecimalDigitFromEnd(unsigned long long v, cardinal k)
+{
+    return (k == 0) ? char('0' + v % 10) : DecimalDigitFromEnd(v / 10, k - 1);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Generator znakow zapisu dziesietnego (znak '-' i modul) dla MakeFixedStr() - wyliczany
+// w czasie kompilacji.
+//
+struct IntCharsGenerator
+{
+    bool negative;
+    unsigned long long magnitude;
+
+    CA_CONSTEXPR cardinal Size() const
+    {
+        return (negative ? 1 : 0) + DecimalLength(magnitude);
+    }
+
+    CA_CONSTEXPR char At(cardinal i) const
+    {
+        return (i >= Size()) ? '\0'
+             : (negative && i == 0) ? '-'
+             : DecimalDigitFromEnd(magnitude, Size() - 1 - i);
+    }
+};
+
+
+} // namespace cans
+
+
+#endif // CA_INTFORMAT_H
@@ -0,0 +1,224 @@
+#ifndef CA_INTPARSE_H
+#define CA_INTPARSE_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memcpy()
+//   <stdint.h>      -> uint32_t, uint64_t
+//
+// Repository
+//   "numutils.h"    -> cardinal, IsDigitSign(), TParseResult, MakeParseResult(), IsParsedWhole()
+//   "strutils.h"    -> IsAsciiDigit()
+//
+
+#include <cstring>
+#include <stdint.h>
+
+#include "numutils.h"
+#include "strutils.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Wczytywanie liczb calkowitych
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Szybka konwersja tekstu dziesietnego [+-]?[0-9]+ na liczby calkowite 32/64-bit, bez strtol(),
+//   bez errno i bez wymogu terminatora '\0'.
+//
+// Zakres odpowiedzialnosci:
+// - ScanDecimalU64(): wspolny silnik - same cyfry, wynik bez znaku z dokladnym wykryciem
+//   przekroczenia zakresu 64-bit.
+// - ScanDecimalUInt() / ScanDecimalInt(): znak i zakres typu docelowego (limit modulu).
+// - Funkcje ScanXxx odczytuja liczbe z poczatku zakresu [first, last) i zwracaja TParseResult
+//   (koniec liczby, status: niepoprawna / poza zakresem); funkcje ParseXxx wymagaja, aby caly
+//   tekst byl liczba.
+//
+// Uwagi projektowe:
+// * Cyfry wczytywane sa porcjami po 8 (SWAR): jedno slowo 64-bit jest sprawdzane, czy zawiera
+//   same cyfry, i zamieniane na wartosc 0..99999999 w trzech krokach mnozenia (pary, czworki,
+//   osemka). Koncowka krotsza niz 8 znakow wczytywana jest znak po znaku.
+// * Zera wiodace sa pomijane, wiec przekroczenie zakresu rozstrzyga sama liczba cyfr znaczacych:
+//   do 19 cyfr wartosc zawsze miesci sie w 64 bitach, 20 cyfr wymaga jednego porownania,
+//   wiecej - zawsze jest bledem.
+// * Biale znaki (takze wiodace) nie sa dopuszczane.
+//
+
+//-------------------------------------------------------------------------------------------------
+// Helper: odczyt 8 bajtow jako slowo 64-bit, w ktorym pierwszy znak jest najmlodszym bajtem.
+//
+inline uint64_t LoadDigitWord(const char* p)
+{
+    uint64_t w;
+    memcpy(&w, p, 8);
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    w = __builtin_bswap64(w);
+#endif
+    return w;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: sprawdzenie, czy wszystkie 8 bajtow slowa to cyfry ASCII '0'..'9'.
+//
+inline bool IsEightDigitsWord(uint64_t w)
+{
+    // Bajty 0x30..0x39 - starsza polowka 3 przed i po dodaniu 6 do mlodszej polowki
+    return ((w & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((w + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: wartosc 8 cyfr ASCII zapisanych w slowie (pierwsza cyfra w najmlodszym bajcie).
+//
+inline uint32_t EightDigitsValue(uint64_t w)
+{
+    w -= 0x3030303030303030ULL;
+    // Pary cyfr (10 * a + b), czworki (100 * ab + cd) i osemka (10000 * abcd + efgh)
+    w = (w * 10 + (w >> 8)) & 0x00FF00FF00FF00FFULL;
+    w = (w * 100 + (w >> 16)) & 0x0000FFFF0000FFFFULL;
+    return static_cast<uint32_t>(w * 10000 + (w >> 32));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt ciagu cyfr dziesietnych (bez znaku) z poczatku zakresu [first, last) jako wartosci
+// 64-bit bez znaku. Odczyt konczy sie na pierwszym znaku innym niz cyfra.
+// Zwraca ParseInvalid, gdy zakres nie zaczyna sie od cyfry, oraz ParseOutOfRange (wskaznik za
+// ostatnia cyfra), gdy wartosc przekracza 2^64 - 1.
+//
+inline TParseResult ScanDecimalU64(const char* first, const char* last, uint64_t& out)
+{
+    // Pominiecie zer wiodacych (nie wplywaja na wartosc ani na zakres)
+    const char* p = first;
+    while (p < last && *p == '0') p++;
+    const char* const digits = p;
+
+    uint64_t v = 0;
+    // Porcje po 8 cyfr (SWAR) - najwyzej dwie, tj. 16 cyfr znaczacych, ...
+    while (last - p >= 8 && p - digits < 16) {
+        const uint64_t w = LoadDigitWord(p);
+        if (!IsEightDigitsWord(w)) break;
+        v = v * 100000000ULL + EightDigitsValue(w);
+        p += 8;
+    }
+    // ... i dalej znak po znaku, do 19 cyfr znaczacych (wartosc miesci sie w 64 bitach)
+    for (; p < last && IsAsciiDigit(*p) && p - digits < 19; p++)
+        v = v * 10 + static_cast<unsigned>(*p - '0');
+
+    if (p == first) return MakeParseResult(first, ParseInvalid);
+
+    // Cyfra nr 20: jedyny przypadek, w ktorym wartosc moze jeszcze zmiescic sie w 64 bitach;
+    // kazda kolejna cyfra to przekroczenie zakresu
+    if (p < last && IsAsciiDigit(*p)) {
+        const unsigned d = static_cast<unsigned>(*p - '0');
+        const uint64_t kMaxDiv10 = 0xFFFFFFFFFFFFFFFFULL / 10;   // 1844674407370955161
+        bool overflow = (v > kMaxDiv10 || (v == kMaxDiv10 && d > 5));
+        v = v * 10 + d;
+        for (p++; p < last && IsAsciiDigit(*p); p++) overflow = true;
+        if (overflow) return MakeParseResult(p, ParseOutOfRange);
+    }
+
+    out = v;
+    return MakeParseResult(p, ParseOk);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby [+]?[0-9]+ z poczatku zakresu [first, last) jako wartosci bez znaku nie wiekszej
+// niz <maxValue>.
+//
+inline TParseResult ScanDecimalUInt(const char* first, const char* last, uint64_t maxValue, uint64_t& out)
+{
+    const char* p = first;
+    if (p < last && *p == '+') p++;
+
+    uint64_t v;
+    const TParseResult result = ScanDecimalU64(p, last, v);
+    if (result.error == ParseInvalid) return MakeParseResult(first, ParseInvalid);
+    if (result.error != ParseOk || v > maxValue) return MakeParseResult(result.ptr, ParseOutOfRange);
+
+    out = v;
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby [+-]?[0-9]+ z poczatku zakresu [first, last) jako wartosci ze znakiem z zakresu
+// [-<maxValue> - 1, <maxValue>] (zakres typu w kodzie uzupelnien do dwoch).
+//
+inline TParseResult ScanDecimalInt(const char* first, const char* last, uint64_t maxValue, long long& out)
+{
+    const char* p = first;
+    bool negative = false;
+    if (p < last && IsDigitSign(*p)) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint64_t v;
+    const TParseResult result = ScanDecimalU64(p, last, v);
+    if (result.error == ParseInvalid) return MakeParseResult(first, ParseInvalid);
+    // Modul liczby ujemnej moze byc o 1 wiekszy niz maksimum dodatnie
+    if (result.error != ParseOk || v > maxValue + (negative ? 1 : 0))
+        return MakeParseResult(result.ptr, ParseOutOfRange);
+
+    // Negacja w arytmetyce bez znaku (poprawna takze dla wartosci minimalnej typu)
+    out = negative ? static_cast<long long>(0ULL - v) : static_cast<long long>(v);
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja <n> cyfr dziesietnych (bez znaku) na wartosc 64-bit bez znaku.
+// Zwraca false, gdy brak cyfr, wystapi znak inny niz cyfra lub wartosc przekracza 2^64 - 1.
+//
+inline bool ParseDecimalU64(const char* p, cardinal n, uint64_t& out)
+{
+    uint64_t v;
+    if (!IsParsedWhole(ScanDecimalU64(p, p + n, v), p + n)) return false;
+
+    out = v;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja tekstu [+]?[0-9]+ na wartosc bez znaku nie wieksza niz <maxValue>.
+//
+inline bool ParseDecimalUInt(const char* p, cardinal n, uint64_t maxValue, uint64_t& out)
+{
+    uint64_t v;
+    if (!IsParsedWhole(ScanDecimalUInt(p, p + n, maxValue, v), p + n)) return false;
+
+    out = v;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja tekstu [+-]?[0-9]+ na wartosc ze znakiem z zakresu [-<maxValue> - 1, <maxValue>].
+//
+inline bool ParseDecimalInt(const char* p, cardinal n, uint64_t maxValue, long long& out)
+{
+    long long v;
+    if (!IsParsedWhole(ScanDecimalInt(p, p + n, maxValue, v), p + n)) return false;
+
+    out = v;
+    return true;
+}
+
+
+} // namespace cans
+
+
+#endif // CA_INTPARSE_H
@@ -0,0 +1,281 @@
+#ifndef CA_NUMCOLUMNS_H
+#define CA_NUMCOLUMNS_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <vector>        -> std::vector
+//
+// Repository
+//   "numutils.h"       -> cardinal
+//   "charset.h"        -> CharSet
+//   "strconverters.h"  -> StrToDbl(), StrToInt()
+//   "strparallel.h"    -> SplitForPool(), kParallelMinSize
+//   "strtokenizer.h"   -> FieldSplitter
+//   "strview.h"        -> StrView
+//   "workerpool.h"     -> WorkerPool
+//
+
+#include <vector>
+
+#include "numutils.h"
+#include "charset.h"
+#include "strconverters.h"
+#include "strparallel.h"
+#include "strtokenizer.h"
+#include "strview.h"
+#include "workerpool.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Wczytywanie kolumn liczbowych
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Zamiana calego bufora z polami liczbowymi (np. plik CSV z kolumna liczb) na ciagla tablice
+//   double / int przygotowana przez wywolujacego - bez tworzenia obiektow string dla pol
+//   i bez wywolan konwerterow na kopiach tekstu.
+//
+// Zakres odpowiedzialnosci:
+// - Pola wyznacza FieldSplitter (zbior separatorow i opcje: przycinanie, pomijanie pustych),
+//   np. FieldSplitter(",\n", FieldSplitter::TrimFields). Pola kolejnych rekordow trafiaja
+//   do tablicy jedno za drugim.
+// - Jeden separator na samym koncu tekstu (np. '\n' konczacy ostatni rekord) nie tworzy
+//   dodatkowego, pustego pola - "1.5,2\n3,4\n" to 4 pola. Puste pola wewnatrz tekstu (np. ",,"
+//   lub pusty wiersz) pozostaja polami (blednymi), o ile nie wybrano opcji SkipEmpty.
+// - Pola niepoprawne (wg StrToDbl() / StrToInt()) dostaja w tablicy wartosc 0, a ich indeksy
+//   trafiaja (rosnaco) do listy <failures>.
+// - Wariant ParallelXxx dzieli bufor na fragmenty konczace sie na separatorze (granica pola),
+//   zlicza pola fragmentow, a nastepnie wczytuje fragmenty rownolegle - kazdy od wlasnego
+//   indeksu w tablicy wynikowej.
+//
+// Uwagi projektowe:
+// * Funkcje zwracaja liczbe wszystkich pol tekstu. Do tablicy zapisywanych jest co najwyzej
+//   <capacity> pierwszych wartosci - wynik wiekszy niz <capacity> oznacza, ze tablica byla
+//   za mala (indeksy bledow obejmuja jednak wszystkie pola).
+// * Wynik wariantu rownoleglego jest identyczny z sekwencyjnym.
+//
+
+//-------------------------------------------------------------------------------------------------
+// Helper: konwertery pol dla poszczegolnych typow (obiekty funkcyjne dla szablonow ponizej)
+//
+struct DblFieldConverter
+{
+    explicit DblFieldConverter(char decimalPoint) : decimalPoint_(decimalPoint) {}
+    bool operator()(StrView field, double& value) const { return StrToDbl(field, value, decimalPoint_); }
+    char decimalPoint_;
+};
+
+struct IntFieldConverter
+{
+    bool operator()(StrView field, int& value) const { return StrToInt(field, value); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: odbiorca pol - konwersja kolejnego pola i zapis pod kolejnym indeksem tablicy.
+//
+template <class T, class Converter>
+struct ColumnSink
+{
+    ColumnSink(T* out, cardinal capacity, cardinal index, std::vector<cardinal>& failures,
+               const Converter& convert)
+        : out_(out), capacity_(capacity), index_(index), failures_(&failures), convert_(convert)
+    {
+    }
+
+    void operator()(StrView field)
+    {
+        T value = T();
+        if (!convert_(field, value)) {
+            failures_->push_back(index_);
+            value = T();
+        }
+        if (index_ < capacity_) out_[index_] = value;
+        index_++;
+    }
+
+    T* out_;
+    cardinal capacity_;
+    cardinal index_;
+    std::vector<cardinal>* failures_;
+    Converter convert_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: licznik pol (odbiorca dla FieldSplitter::ForEachField()).
+//
+struct FieldCounter
+{
+    void operator()(StrView) const {}
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: przekazanie pol fragmentu <piece> lezacego pomiedzy separatorami (lub krancami tekstu).
+// W odroznieniu od ForEachField() pusty fragment jest jednym (pustym) polem.
+//
+template <class Callback>
+cardinal ForEachFieldOfPiece(const FieldSplitter& splitter, StrView piece, Callback& callback)
+{
+    if (!piece.empty()) return splitter.ForEachField(piece, callback);
+    if (splitter.OptionFlags() & FieldSplitter::SkipEmpty) return 0;
+
+    callback(piece);
+    return 1;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: tekst bez jednego koncowego separatora (np. '\n' konczacego ostatni rekord pliku).
+//
+inline StrView WithoutTrailingDelimiter(StrView text, const FieldSplitter& splitter)
+{
+    if (!text.empty() && splitter.Delimiters().Contains(text[text.size() - 1]))
+        return text.substr(0, text.size() - 1);
+    return text;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: wczytanie wszystkich pol tekstu (takze pola za koncowym separatorem) - sekwencyjnie.
+//
+template <class T, class Converter>
+cardinal ParseColumnFields(StrView text, const FieldSplitter& splitter, T* out, cardinal capacity,
+                           std::vector<cardinal>& failures, const Converter& convert)
+{
+    failures.clear();
+    return splitter.ForEachField(text, ColumnSink<T, Converter>(out, capacity, 0, failures, convert));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: wspolna implementacja wczytania kolumny - sekwencyjnie.
+//
+template <class T, class Converter>
+cardinal ParseColumn(StrView text, const FieldSplitter& splitter, T* out, cardinal capacity,
+                     std::vector<cardinal>& failures, const Converter& convert)
+{
+    return ParseColumnFields(WithoutTrailingDelimiter(text, splitter), splitter, out, capacity,
+                             failures, convert);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: wspolna implementacja wczytania kolumny - rownolegle.
+//
+template <class T, class Converter>
+cardinal ParallelParseColumn(StrView text, const FieldSplitter& splitter, T* out, cardinal capacity,
+                             std::vector<cardinal>& failures, const Converter& convert,
+                             WorkerPool& pool, cardinal minSize)
+{
+    text = WithoutTrailingDelimiter(text, splitter);
+    const cardinal n = text.size();
+    if (n == 0 || n < minSize || pool.Size() < 2)
+        return ParseColumnFields(text, splitter, out, capacity, failures, convert);
+
+    // Granice fragmentow: pierwszy separator na lub za nominalnym poczatkiem kolejnego fragmentu
+    // (fragment k to tekst pomiedzy separatorami bounds[k] - 1 i bounds[k + 1] - 1)
+    const char* p = text.data();
+    const CharSet& delimiters = splitter.Delimiters();
+    cardinal chunk = 0;
+    const cardinal parts = SplitForPool(n, pool, chunk);
+    std::vector<cardinal> bounds(1, 0);
+    for (cardinal k = 1; k < parts; k++) {
+        cardinal i = k * chunk;
+        if (i < bounds.back()) i = bounds.back();
+        while (i < n && !delimiters.Contains(p[i])) i++;
+        if (i >= n) break;
+        bounds.push_back(i + 1);
+    }
+    const cardinal pieces = bounds.size();
+    bounds.push_back(n + 1);
+
+    // Faza 1: liczba pol kazdego fragmentu
+    std::vector<cardinal> first(pieces + 1, 0);
+    cardinal* firstp = &first[0];
+    const cardinal* boundsp = &bounds[0];
+    pool.Run(pieces, [=, &splitter](cardinal k) {
+        FieldCounter counter;
+        const StrView piece(p + boundsp[k], boundsp[k + 1] - 1 - boundsp[k]);
+        firstp[k + 1] = ForEachFieldOfPiece(splitter, piece, counter);
+    });
+    // ... i indeks pierwszego pola fragmentu (suma prefiksowa)
+    for (cardinal k = 0; k < pieces; k++) first[k + 1] += first[k];
+
+    // Faza 2: wczytanie fragmentow, kazdy od wlasnego indeksu tablicy i z wlasna lista bledow
+    std::vector<std::vector<cardinal> > pieceFailures(pieces);
+    std::vector<cardinal>* failuresp = &pieceFailures[0];
+    pool.Run(pieces, [=, &splitter, &convert](cardinal k) {
+        ColumnSink<T, Converter> sink(out, capacity, firstp[k], failuresp[k], convert);
+        const StrView piece(p + boundsp[k], boundsp[k + 1] - 1 - boundsp[k]);
+        ForEachFieldOfPiece(splitter, piece, sink);
+    });
+
+    // Polaczenie list bledow (fragmenty sa uporzadkowane, wiec indeksy pozostaja rosnace)
+    failures.clear();
+    for (cardinal k = 0; k < pieces; k++)
+        failures.insert(failures.end(), pieceFailures[k].begin(), pieceFailures[k].end());
+    return first[pieces];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Wczytanie pol liczb rzeczywistych z tekstu <text> do tablicy <out> (o pojemnosci <capacity>).
+// Indeksy pol niepoprawnych trafiaja do <failures>. Zwraca liczbe wszystkich pol.
+//
+inline cardinal ParseDblColumn(StrView text, const FieldSplitter& splitter, double* out, cardinal capacity,
+                               std::vector<cardinal>& failures, char decimalPoint = '.')
+{
+    return ParseColumn(text, splitter, out, capacity, failures, DblFieldConverter(decimalPoint));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Wczytanie pol liczb calkowitych z tekstu <text> do tablicy <out> (o pojemnosci <capacity>).
+// Indeksy pol niepoprawnych trafiaja do <failures>. Zwraca liczbe wszystkich pol.
+//
+inline cardinal ParseIntColumn(StrView text, const FieldSplitter& splitter, int* out, cardinal capacity,
+                               std::vector<cardinal>& failures)
+{
+    return ParseColumn(text, splitter, out, capacity, failures, IntFieldConverter());
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Wczytanie pol liczb rzeczywistych - rownolegle (jak ParseDblColumn()).
+//
+inline cardinal ParallelParseDblColumn(StrView text, const FieldSplitter& splitter, double* out,
+                                       cardinal capacity, std::vector<cardinal>& failures,
+                                       WorkerPool& pool, char decimalPoint = '.',
+                                       cardinal minSize = kParallelMinSize)
+{
+    return ParallelParseColumn(text, splitter, out, capacity, failures, DblFieldConverter(decimalPoint),
+                               pool, minSize);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Wczytanie pol liczb calkowitych - rownolegle (jak ParseIntColumn()).
+//
+inline cardinal ParallelParseIntColumn(StrView text, const FieldSplitter& splitter, int* out,
+                                       cardinal capacity, std::vector<cardinal>& failures,
+                                       WorkerPool& pool, cardinal minSize = kParallelMinSize)
+{
+    return ParallelParseColumn(text, splitter, out, capacity, failures, IntFieldConverter(),
+                               pool, minSize);
+}
+
+
+} // namespace cans
+
+
+#endif // CA_NUMCOLUMNS_H
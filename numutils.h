@@ -11,6 +11,28 @@
 #include <cmath>
 
 
+//-------------------------------------------------------------------------------------------------
+// Funkcje i dane wyliczalne w czasie kompilacji:
+//   CA_CONSTEXPR       - constexpr w postaci C++11 (cialo to pojedyncze "return")
+//   CA_CONSTEXPR14     - constexpr od C++14 (petle, zmienne lokalne, switch), wczesniej inline
+//   CA_CONSTEXPR_DATA  - stala tablica dostepna w wyrazeniach stalych
+// Kompilatory bez constexpr (MSVC < 2015) dostaja zwykle funkcje inline / stale.
+//
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define CA_CONSTEXPR inline
+#define CA_CONSTEXPR_DATA const
+#else
+#define CA_CONSTEXPR constexpr
+#define CA_CONSTEXPR_DATA constexpr
+#endif
+
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define CA_CONSTEXPR14 constexpr
+#else
+#define CA_CONSTEXPR14 inline
+#endif
+
+
 
 
 namespace cans
@@ -20,26 +42,22 @@ namespace cans
 //-------------------------------------------------------------------------------------------------
 // Przyciecie liczby calkowitej do podanego zakresu
 //
-inline int ClampInt(int i, int lo, int hi)
+CA_CONSTEXPR int ClampInt(int i, int lo, int hi)
 {
-    // Jesli podana liczba wykracza poza zakres, zwrocenie wartosci granicznej (dol/gora), ...
-    if (i < lo) return lo;
-    if (i > hi) return hi;
-    // ... w przeciwnym razie zwrocenie podanej wartosci
-    return i;
+    // Jesli podana liczba wykracza poza zakres, zwrocenie wartosci granicznej (dol/gora),
+    // w przeciwnym razie zwrocenie podanej wartosci
+    return (i < lo) ? lo : ((i > hi) ? hi : i);
 }
 
 
 //-------------------------------------------------------------------------------------------------
 // Przyciecie liczby rzeczywistej do podanego zakresu
 //
-inline double ClampDbl(double i, double lo, double hi)
+CA_CONSTEXPR double ClampDbl(double i, double lo, double hi)
 {
-    // Jesli podana liczba wykracza poza zakres, zwrocenie wartosci granicznej (dol/gora), ...
-    if (i < lo) return lo;
-    if (i > hi) return hi;
-    // ... w przeciwnym razie zwrocenie podanej wartosci
-    return i;
+    // Jesli podana liczba wykracza poza zakres, zwrocenie wartosci granicznej (dol/gora),
+    // w przeciwnym razie zwrocenie podanej wartosci
+    return (i < lo) ? lo : ((i > hi) ? hi : i);
 }
 
 
@@ -55,7 +73,7 @@ inline bool AlmostEqual(double a, double b, double epsilon = 1E-9)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy podany znak ASCII to plus/minus [+-]
 //
-inline bool IsDigitSign(char ch)
+CA_CONSTEXPR bool IsDigitSign(char ch)
 {
     return (ch == '+' || ch == '-');
 }
@@ -64,7 +82,7 @@ inline bool IsDigitSign(char ch)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie czy podany znak ASCII to marker wykladnika [Ee]
 //
-inline bool IsExponentMarker(char ch)
+CA_CONSTEXPR bool IsExponentMarker(char ch)
 {
     return (ch == 'E' || ch == 'e');
 }
@@ -73,22 +91,56 @@ inline bool IsExponentMarker(char ch)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy podany znak ASCII reprezentuje cyfre rzymska [CDILMVX].
 //
-inline bool IsRomanDigit(char ch)
+CA_CONSTEXPR bool IsRomanDigit(char ch)
+{
+    return (ch == 'I' ||   //    1
+            ch == 'V' ||   //    5
+            ch == 'X' ||   //   10
+            ch == 'L' ||   //   50
+            ch == 'C' ||   //  100
+            ch == 'D' ||   //  500
+            ch == 'M');    // 1000
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Status odczytu liczby z zakresu znakow [first, last)
+//
+enum ParseStatus
+{
+    ParseOk = 0,       // odczytano wartosc
+    ParseInvalid,      // brak liczby na poczatku zakresu
+    ParseOutOfRange    // liczba poprawna skladniowo, lecz nie miesci sie w typie docelowym
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Wynik odczytu liczby z zakresu znakow (w stylu std::from_chars): <ptr> wskazuje pierwszy znak
+// za rozpoznana liczba (dla ParseInvalid - poczatek zakresu), a <error> to status odczytu.
+// Wartosc docelowa zmieniana jest wylacznie dla ParseOk.
+//
+struct TParseResult
+{
+    const char* ptr;
+    ParseStatus error;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Utworzenie wyniku odczytu.
+//
+CA_CONSTEXPR TParseResult MakeParseResult(const char* ptr, ParseStatus error)
+{
+    return TParseResult{ ptr, error };
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Sprawdzenie, czy odczyt zakonczyl sie powodzeniem i objal caly zakres (az do <last>).
+//
+CA_CONSTEXPR bool IsParsedWhole(const TParseResult& result, const char* last)
 {
-    switch (ch)
-    {
-        case 'I':   //    1
-        case 'V':   //    5
-        case 'X':   //   10
-        case 'L':   //   50
-        case 'C':   //  100
-        case 'D':   //  500
-        case 'M':   // 1000
-            return true;
-
-        default:
-            return false;
-    }
+    return result.error == ParseOk && result.ptr == last;
 }
 
 
@@ -0,0 +1,294 @@
+#ifndef CA_RADIX_H
+#define CA_RADIX_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memcpy()
+//   <stdint.h>      -> uint32_t, uint64_t
+//
+// Repository
+//   "numutils.h"    -> cardinal, CA_CONSTEXPR14, IsDigitSign()
+//   "intformat.h"   -> BitLength64(), UIntToChars(), UInt64ToChars()
+//   "intparse.h"    -> ParseDecimalU64()
+//   "strkernels.h"  -> HexEncodeBlock(), HexDecodeBlock()
+//
+
+#include <cstring>
+#include <stdint.h>
+
+#include "numutils.h"
+#include "intformat.h"
+#include "intparse.h"
+#include "strkernels.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Liczby calkowite w dowolnej podstawie (2..36)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Zapis i odczyt liczb calkowitych 32/64-bit w podstawach 2..36 (dwojkowa, osemkowa,
+//   szesnastkowa, base-36 itd.) oraz kodowanie szesnastkowe calych buforow bajtow.
+//
+// Zakres odpowiedzialnosci:
+// - Cyfry: '0'..'9', potem litery 'a'..'z' (wielkie litery na zadanie); przy odczycie wielkosc
+//   liter nie ma znaczenia. Bez przedrostkow ("0x", "0b") i bez bialych znakow.
+// - Odczyt wg tych samych zasad co StrToInt(): [+-]?cyfry (znak '-' tylko dla typow ze znakiem),
+//   caly tekst musi byc liczba, przekroczenie zakresu typu jest bledem (dokladnie, bez errno).
+// - Kodowanie / dekodowanie szesnastkowe buforow - jadra wektorowe z strkernels.h.
+//
+// Uwagi projektowe:
+// * Podstawy bedace potega 2 (2, 4, 8, 16, 32) - przesuniecia i maski: cyfra to kolejne k bitow
+//   (k = log2 podstawy), liczba cyfr wynika z dlugosci bitowej wartosci, a przekroczenie zakresu
+//   przy odczycie - z liczby bitow znaczacych.
+// * Podstawa 10 korzysta z dedykowanych sciezek dziesietnych (intformat.h, intparse.h).
+// * Pozostale podstawy - dzielenie / mnozenie z kontrola przekroczenia przez porownanie
+//   z (max / podstawa, max % podstawa) wyznaczonymi raz na wywolanie.
+//
+
+const cardinal kRadixCharsMax = 65;   // najdluzszy wynik: "-" i 64 cyfry dwojkowe
+
+static const char kRadixDigitsLower[37] = "0123456789abcdefghijklmnopqrstuvwxyz";
+static const char kRadixDigitsUpper[37] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: log2 podstawy bedacej potega 2 (1..5) lub 0 dla pozostalych podstaw.
+//
+CA_CONSTEXPR14 int RadixShift(int base)
+{
+    switch (base)
+    {
+        case 2:  return 1;
+        case 4:  return 2;
+        case 8:  return 3;
+        case 16: return 4;
+        case 32: return 5;
+        default: return 0;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: wartosc cyfry [0-9a-zA-Z] (0..35) lub 36 dla innych znakow.
+//
+CA_CONSTEXPR14 unsigned RadixDigitValue(char ch)
+{
+    const unsigned c = static_cast<unsigned char>(ch);
+    if (c - '0' < 10) return c - '0';
+    const unsigned alpha = (c | 0x20) - 'a';
+    return (alpha < 26) ? alpha + 10 : 36;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: zapis wartosci bez znaku (32 lub 64-bit) w podstawie <base>.
+//
+template <class Unsigned>
+char* UnsignedToCharsRadix(Unsigned v, int base, char* out, bool uppercase)
+{
+    const char* digits = uppercase ? kRadixDigitsUpper : kRadixDigitsLower;
+
+    // Potega 2: liczba cyfr z dlugosci bitowej, cyfry - kolejne grupy bitow od konca
+    const int shift = RadixShift(base);
+    if (shift) {
+        const cardinal bits = BitLength64(v);
+        const cardinal n = (bits == 0) ? 1 : (bits + shift - 1) / shift;
+        const Unsigned mask = static_cast<Unsigned>(base - 1);
+        for (char* p = out + n; p != out; v >>= shift) *--p = digits[v & mask];
+        return out + n;
+    }
+
+    // Pozostale podstawy: cyfry od najmlodszej do bufora pomocniczego, potem w kolejnosci
+    char buf[64];
+    char* p = buf + sizeof(buf);
+    const Unsigned b = static_cast<Unsigned>(base);
+    do {
+        *--p = digits[v % b];
+        v /= b;
+    } while (v != 0);
+    const cardinal n = static_cast<cardinal>(buf + sizeof(buf) - p);
+    memcpy(out, p, n);
+    return out + n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis liczby bez znaku (64-bit) w podstawie <base> (2..36) do bufora <out> (bez terminatora;
+// bufor musi pomiescic kRadixCharsMax znakow). Zwraca wskaznik za ostatnim znakiem; dla podstawy
+// spoza zakresu nic nie jest zapisywane.
+//
+inline char* UInt64ToCharsRadix(unsigned long long value, int base, char* out, bool uppercase = false)
+{
+    if (base < 2 || base > 36) return out;
+    if (base == 10) return UInt64ToChars(value, out);
+    return UnsignedToCharsRadix(static_cast<uint64_t>(value), base, out, uppercase);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis liczby bez znaku (32-bit) w podstawie <base> (jak UInt64ToCharsRadix()).
+//
+inline char* UIntToCharsRadix(unsigned value, int base, char* out, bool uppercase = false)
+{
+    if (base < 2 || base > 36) return out;
+    if (base == 10) return UIntToChars(value, out);
+    return UnsignedToCharsRadix(static_cast<uint32_t>(value), base, out, uppercase);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis liczby ze znakiem (64-bit) w podstawie <base>: '-' i modul (jak UInt64ToCharsRadix()).
+//
+inline char* Int64ToCharsRadix(long long value, int base, char* out, bool uppercase = false)
+{
+    if (base < 2 || base > 36) return out;
+    // Modul liczony w arytmetyce bez znaku (poprawny takze dla LLONG_MIN)
+    unsigned long long u = static_cast<unsigned long long>(value);
+    if (value < 0) {
+        *out++ = '-';
+        u = 0ULL - u;
+    }
+    return UInt64ToCharsRadix(u, base, out, uppercase);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis liczby ze znakiem (32-bit) w podstawie <base> (jak Int64ToCharsRadix()).
+//
+inline char* IntToCharsRadix(int value, int base, char* out, bool uppercase = false)
+{
+    if (base < 2 || base > 36) return out;
+    unsigned u = static_cast<unsigned>(value);
+    if (value < 0) {
+        *out++ = '-';
+        u = 0u - u;
+    }
+    return UIntToCharsRadix(u, base, out, uppercase);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt <n> cyfr w podstawie <base> (2..36, bez znaku) jako wartosci 64-bit bez znaku.
+// Zwraca false, gdy brak cyfr, wystapi znak niebedacy cyfra podstawy lub wartosc przekracza
+// 2^64 - 1.
+//
+inline bool ParseRadixU64(const char* p, cardinal n, int base, uint64_t& out)
+{
+    if (base < 2 || base > 36 || n == 0) return false;
+    if (base == 10) return ParseDecimalU64(p, n, out);
+
+    const char* const end = p + n;
+    const unsigned b = static_cast<unsigned>(base);
+    uint64_t v = 0;
+
+    const int shift = RadixShift(base);
+    if (shift) {
+        // Potega 2: po pominieciu zer wiodacych liczba bitow znaczacych rozstrzyga o zakresie
+        while (p < end && *p == '0') p++;
+        if (p < end) {
+            const unsigned first = RadixDigitValue(*p);
+            if (first >= b) return false;
+            const cardinal bits = BitLength64(first) + static_cast<cardinal>(end - p - 1) * shift;
+            if (bits > 64) {
+                for (p++; p < end; p++) if (RadixDigitValue(*p) >= b) return false;
+                return false;
+            }
+        }
+        for (; p < end; p++) {
+            const unsigned d = RadixDigitValue(*p);
+            if (d >= b) return false;
+            v = (v << shift) | d;
+        }
+        out = v;
+        return true;
+    }
+
+    // Pozostale podstawy: v * base + d <= max  <=>  v < max / base lub (v == max / base
+    // i d <= max % base)
+    const uint64_t kMax = 0xFFFFFFFFFFFFFFFFULL;
+    const uint64_t maxDiv = kMax / b;
+    const unsigned maxRem = static_cast<unsigned>(kMax % b);
+    for (; p < end; p++) {
+        const unsigned d = RadixDigitValue(*p);
+        if (d >= b) return false;
+        if (v > maxDiv || (v == maxDiv && d > maxRem)) return false;
+        v = v * b + d;
+    }
+
+    out = v;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt tekstu [+]?cyfry w podstawie <base> jako wartosci bez znaku nie wiekszej niz <maxValue>.
+//
+inline bool ParseRadixUInt(const char* p, cardinal n, int base, uint64_t maxValue, uint64_t& out)
+{
+    if (n > 0 && *p == '+') { p++; n--; }
+
+    uint64_t v;
+    if (!ParseRadixU64(p, n, base, v) || v > maxValue) return false;
+
+    out = v;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt tekstu [+-]?cyfry w podstawie <base> jako wartosci ze znakiem z zakresu
+// [-<maxValue> - 1, <maxValue>] (jak ParseDecimalInt()).
+//
+inline bool ParseRadixInt(const char* p, cardinal n, int base, uint64_t maxValue, long long& out)
+{
+    bool negative = false;
+    if (n > 0 && IsDigitSign(*p)) {
+        negative = (*p == '-');
+        p++;
+        n--;
+    }
+
+    uint64_t v;
+    if (!ParseRadixU64(p, n, base, v) || v > maxValue + (negative ? 1 : 0)) return false;
+
+    out = negative ? static_cast<long long>(0ULL - v) : static_cast<long long>(v);
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis <n> bajtow <data> jako 2 * n cyfr szesnastkowych do <out> (bez terminatora).
+// Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* HexEncode(const void* data, cardinal n, char* out, bool uppercase = false)
+{
+    HexEncodeBlock(static_cast<const unsigned char*>(data), n, out,
+                   uppercase ? kRadixDigitsUpper : kRadixDigitsLower);
+    return out + 2 * n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt <n> cyfr szesnastkowych <hex> jako n / 2 bajtow do <out>. Zwraca false dla nieparzystej
+// liczby znakow lub znaku spoza [0-9a-fA-F] (zawartosc <out> jest wtedy nieokreslona).
+//
+inline bool HexDecode(const char* hex, cardinal n, unsigned char* out)
+{
+    if (n % 2 != 0) return false;
+    return HexDecodeBlock(hex, n / 2, out);
+}
+
+
+} // namespace cans
+
+
+#endif // CA_RADIX_H
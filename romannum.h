@@ -0,0 +1,346 @@
+#ifndef CA_ROMANNUM_H
+#define CA_ROMANNUM_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memcpy()
+//   <vector>        -> std::vector
+//
+// Repository
+//   "numutils.h"    -> cardinal, CA_CONSTEXPR, CA_CONSTEXPR14, CA_CONSTEXPR_DATA, TParseResult,
+//                      MakeParseResult(), IsParsedWhole()
+//   "strview.h"     -> StrView
+//
+
+#include <cstring>
+#include <vector>
+
+#include "numutils.h"
+#include "strview.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Numeracja rzymska
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Konwersja liczb 1..ROMAN_MAX na zapis rzymski i z powrotem - pojedynczo oraz dla tablic.
+//
+// Zakres odpowiedzialnosci:
+// - Kodowanie: kazda cyfra dziesietna (tysiace, setki, dziesiatki, jednosci) ma gotowy fragment
+//   zapisu w tablicy kRomanFragments - wynik to zlaczenie co najwyzej czterech fragmentow.
+// - Kodowanie w czasie kompilacji: RomanCharsGenerator (dla MakeFixedStr()) wylicza kolejne
+//   znaki z tych samych fragmentow.
+// - Dekodowanie: automat skonczony (jedno przejscie, jedna tablica przejsc) przyjmuje wylacznie
+//   zapis kanoniczny, tj. dokladnie taki, jaki daje kodowanie (odrzuca np. "IIII", "IM", "VX").
+//
+// Uwagi projektowe:
+// * Stan automatu to grupa dziesietna (0 = jednosci .. 3 = tysiace) i postep w jej obrebie:
+//   po "I" / "II" / "III" / "V" / "VI" / "VII" / "VIII" lub po zamknieciu grupy ("IV", "IX").
+//   Kolejna grupa moze zaczac sie wylacznie od symboli nizszego rzedu - stad kolejnosc
+//   i kanonicznosc grup.
+// * Tablica przejsc budowana jest raz (przy pierwszym uzyciu) z regul dla jednej grupy.
+//
+
+#define ROMAN_MAX 3999   // gorna granica numeracji rzymskiej ("MMMCMXCIX")
+
+const cardinal kRomanCharsMax = 15;   // najdluzszy zapis: "MMMDCCCLXXXVIII"
+
+
+//-------------------------------------------------------------------------------------------------
+// Fragment zapisu rzymskiego dla jednej cyfry dziesietnej
+//
+struct TRomanFragment
+{
+    char text[5];
+    unsigned char size;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Tablica fragmentow: [rzad dziesietny: 0 = jednosci .. 3 = tysiace][cyfra 0..9]
+//
+static CA_CONSTEXPR_DATA TRomanFragment kRomanFragments[4][10] =
+{
+    { {"", 0}, {"I", 1}, {"II", 2}, {"III", 3}, {"IV", 2},
+      {"V", 1}, {"VI", 2}, {"VII", 3}, {"VIII", 4}, {"IX", 2} },
+    { {"", 0}, {"X", 1}, {"XX", 2}, {"XXX", 3}, {"XL", 2},
+      {"L", 1}, {"LX", 2}, {"LXX", 3}, {"LXXX", 4}, {"XC", 2} },
+    { {"", 0}, {"C", 1}, {"CC", 2}, {"CCC", 3}, {"CD", 2},
+      {"D", 1}, {"DC", 2}, {"DCC", 3}, {"DCCC", 4}, {"CM", 2} },
+    { {"", 0}, {"M", 1}, {"MM", 2}, {"MMM", 3}, {"", 0},
+      {"", 0}, {"", 0}, {"", 0}, {"", 0}, {"", 0} }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: dopisanie fragmentu do bufora (zawsze kopiowane 4 bajty; przy zapisie calej liczby
+// nie wykraczaja one poza kRomanCharsMax znakow).
+//
+inline char* AppendRomanFragment(char* out, const TRomanFragment& fragment)
+{
+    memcpy(out, fragment.text, 4);
+    return out + fragment.size;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis liczby <value> (1..ROMAN_MAX) w numeracji rzymskiej do bufora <out> (bez terminatora;
+// bufor musi pomiescic kRomanCharsMax znakow). Zwraca wskaznik za ostatnim znakiem, a dla
+// wartosci spoza zakresu - <out> (pusty wynik).
+//
+inline char* IntToRomanChars(int value, char* out)
+{
+    if (value < 1 || ROMAN_MAX < value) return out;
+
+    const unsigned v = static_cast<unsigned>(value);
+    out = AppendRomanFragment(out, kRomanFragments[3][v / 1000]);
+    out = AppendRomanFragment(out, kRomanFragments[2][v / 100 % 10]);
+    out = AppendRomanFragment(out, kRomanFragments[1][v / 10 % 10]);
+    return AppendRomanFragment(out, kRomanFragments[0][v % 10]);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: fragment zapisu rzymskiego cyfry rzedu <g> (0 = jednosci .. 3 = tysiace) wartosci <v>
+// (postac constexpr C++11).
+//
+CA_CONSTEXPR const TRomanFragment& RomanFragmentOf(unsigned v, int g)
+{
+    return kRomanFragments[g][(g == 0 ? v : g == 1 ? v / 10 : g == 2 ? v / 100 : v / 1000) % 10];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: dlugosc zapisu rzymskiego rzedow <g>..0 wartosci <v> (postac constexpr C++11).
+//
+CA_CONSTEXPR cardinal RomanLength(unsigned v, int g = 3)
+{
+    return (g < 0) ? 0 : RomanFragmentOf(v, g).size + RomanLength(v, g - 1);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: znak nr <i> zapisu rzymskiego rzedow <g>..0 wartosci <v> ('\0' za zapisem).
+//
+CA_CONSTEXPR char RomanCharAt(unsigned v, cardinal i, int g = 3)
+{
+    return (g < 0) ? '\0'
+         : (i < RomanFragmentOf(v, g).size) ? RomanFragmentOf(v, g).text[i]
+         : RomanCharAt(v, i - RomanFragmentOf(v, g).size, g - 1);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Generator znakow zapisu rzymskiego dla MakeFixedStr() - wyliczany w czasie kompilacji.
+// Wartosc 0 daje pusty zapis.
+//
+struct RomanCharsGenerator
+{
+    unsigned value;   // 0..ROMAN_MAX
+
+    CA_CONSTEXPR cardinal Size() const { return RomanLength(value); }
+    CA_CONSTEXPR char At(cardinal i) const { return RomanCharAt(value, i); }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: indeks symbolu rzymskiego (I=0, V=1, X=2, L=3, C=4, D=5, M=6) lub -1 dla innych znakow.
+// Symbol 2g to "jeden", a 2g + 1 to "piec" jednostek rzedu g.
+//
+CA_CONSTEXPR14 int RomanSymbolIndex(char ch)
+{
+    switch (ch)
+    {
+        case 'I': return 0;
+        case 'V': return 1;
+        case 'X': return 2;
+        case 'L': return 3;
+        case 'C': return 4;
+        case 'D': return 5;
+        case 'M': return 6;
+        default:  return -1;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Automat dekodujacy zapis rzymski: stan 0 - poczatek, stany 1 + 8g + k - grupa g, postep k
+//
+class RomanDecoder
+{
+public:
+    enum
+    {
+        kStates  = 1 + 4 * 8,
+        kSymbols = 7,
+        kReject  = -1
+    };
+
+    //---------------------------------------------------------------------------------------------
+    // Automat wspoldzielony (tablica przejsc budowana przy pierwszym uzyciu).
+    //
+    static const RomanDecoder& Instance()
+    {
+        static const RomanDecoder decoder;
+        return decoder;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Odczyt najdluzszego kanonicznego zapisu liczby 1..ROMAN_MAX z poczatku zakresu
+    // [first, last). Odczyt konczy sie na pierwszym znaku, ktory nie moze przedluzyc zapisu
+    // (np. dla "XIIII" odczytane zostaje "XIII"). Zwraca ParseInvalid, gdy zakres nie zaczyna
+    // sie od symbolu rzymskiego (<out> pozostaje wtedy bez zmian).
+    //
+    TParseResult Scan(const char* first, const char* last, int& out) const
+    {
+        int state = 0;
+        int value = 0;
+        const char* p = first;
+        for (; p < last; p++) {
+            const int s = RomanSymbolIndex(*p);
+            if (s < 0) break;
+            const TTransition& t = table_[state][s];
+            if (t.next == kReject) break;
+            state = t.next;
+            value += t.add;
+        }
+        if (p == first) return MakeParseResult(first, ParseInvalid);
+
+        out = value;
+        return MakeParseResult(p, ParseOk);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Dekodowanie <n> znakow <p>. Zwraca false, gdy tekst nie jest kanonicznym zapisem liczby
+    // 1..ROMAN_MAX (<out> pozostaje wtedy bez zmian).
+    //
+    bool Decode(const char* p, cardinal n, int& out) const
+    {
+        int value;
+        if (!IsParsedWhole(Scan(p, p + n, value), p + n)) return false;
+
+        out = value;
+        return true;
+    }
+
+private:
+    // Postep w obrebie grupy: po I, II, III, V, VI, VII, VIII oraz grupa zamknieta (IV, IX)
+    enum { kOne1, kOne2, kOne3, kFive, kFive1, kFive2, kFive3, kClosed };
+
+    struct TTransition
+    {
+        signed char next;   // stan nastepny lub kReject
+        short add;          // wartosc doliczana przy przejsciu
+    };
+
+    RomanDecoder()
+    {
+        static const short kUnit[4] = { 1, 10, 100, 1000 };
+
+        for (int state = 0; state < kStates; state++) {
+            // Grupa biezaca (poczatek - ponad tysiacami) i postep w jej obrebie
+            const int g = (state == 0) ? 4 : (state - 1) / 8;
+            const int k = (state == 0) ? kClosed : (state - 1) % 8;
+
+            for (int s = 0; s < kSymbols; s++) {
+                TTransition t = { kReject, 0 };
+                const int h = s / 2;
+                const bool five = (s % 2) != 0;
+
+                if (h < g) {
+                    // Poczatek grupy nizszego rzedu: "jeden" lub "piec"
+                    t.next = static_cast<signed char>(1 + 8 * h + (five ? kFive : kOne1));
+                    t.add = static_cast<short>(five ? 5 * kUnit[h] : kUnit[h]);
+                }
+                else if (h == g && !five && (k == kOne1 || k == kOne2 || (k >= kFive && k < kFive3))) {
+                    // Kolejne "jeden" w grupie (najwyzej trzy, takze po "piec")
+                    t.next = static_cast<signed char>(state + 1);
+                    t.add = kUnit[g];
+                }
+                else if (g < 3 && k == kOne1 && s == 2 * g + 1) {
+                    // "jeden" + "piec" = 4 jednostki (doliczone juz 1)
+                    t.next = static_cast<signed char>(1 + 8 * g + kClosed);
+                    t.add = static_cast<short>(3 * kUnit[g]);
+                }
+                else if (g < 3 && k == kOne1 && s == 2 * g + 2) {
+                    // "jeden" + "dziesiec" = 9 jednostek (doliczone juz 1)
+                    t.next = static_cast<signed char>(1 + 8 * g + kClosed);
+                    t.add = static_cast<short>(8 * kUnit[g]);
+                }
+                table_[state][s] = t;
+            }
+        }
+    }
+
+    TTransition table_[kStates][kSymbols];
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby zapisanej w numeracji rzymskiej (<n> znakow <p>, tylko zapis kanoniczny).
+//
+inline bool RomanCharsToInt(const char* p, cardinal n, int& out)
+{
+    return RomanDecoder::Instance().Decode(p, n, out);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis tablicy liczb w numeracji rzymskiej do bufora <out>, z <separator> po kazdej liczbie
+// (wartosci spoza zakresu daja puste pole). Bufor musi pomiescic count * (kRomanCharsMax + 1)
+// znakow. Zwraca wskaznik za ostatnim znakiem.
+//
+inline char* IntsToRomanChars(const int* values, cardinal count, char separator, char* out)
+{
+    for (cardinal i = 0; i < count; i++) {
+        out = IntToRomanChars(values[i], out);
+        *out++ = separator;
+    }
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby zapisanej w numeracji rzymskiej z poczatku zakresu [first, last)
+// (jak RomanDecoder::Scan()).
+//
+inline TParseResult ScanRomanChars(const char* first, const char* last, int& out)
+{
+    return RomanDecoder::Instance().Scan(first, last, out);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt tablicy zapisow rzymskich do tablicy liczb <out>. Pola niepoprawne dostaja wartosc 0,
+// a ich indeksy trafiaja (rosnaco) do <failures>. Zwraca liczbe pol poprawnych.
+//
+inline cardinal RomanCharsToInts(const StrView* inputs, cardinal count, int* out,
+                                 std::vector<cardinal>& failures)
+{
+    const RomanDecoder& decoder = RomanDecoder::Instance();
+    failures.clear();
+    for (cardinal i = 0; i < count; i++) {
+        int value = 0;
+        if (!decoder.Decode(inputs[i].data(), inputs[i].size(), value)) {
+            failures.push_back(i);
+            value = 0;
+        }
+        out[i] = value;
+    }
+    return count - failures.size();
+}
+
+
+} // namespace cans
+
+
+#endif // CA_ROMANNUM_H
@@ -0,0 +1,237 @@
+#ifndef CA_STRCOLUMN_H
+#define CA_STRCOLUMN_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memmove()
+//   <string>        -> std::string
+//   <vector>        -> std::vector
+//
+// Repository
+//   "numutils.h"    -> cardinal
+//   "charset.h"     -> CharSet
+//   "strkernels.h"  -> AsciiLowercaseBlock(), AsciiUppercaseBlock(), ReplaceCharBlock(),
+//                      RemoveCharsCopyBlock()
+//   "strutils.h"    -> LetterCase, ToUpperAlpha(), TrimView()
+//   "strview.h"     -> StrView
+//
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "numutils.h"
+#include "charset.h"
+#include "strkernels.h"
+#include "strutils.h"
+#include "strview.h"
+
+
+
+
+namespace cans
+{
+    using std::string;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Kolumna tekstow (kontener wsadowy)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Kontener wielu krotkich tekstow przechowywanych jeden za drugim w jednym buforze, wraz
+//   z tablica przesuniec. Zamiast jednej alokacji na kazdy tekst (jak w std::vector<string>)
+//   sa dwie alokacje na cala kolumne, a dane leza w pamieci w sposob ciagly.
+//
+// Zakres odpowiedzialnosci:
+// - Dopisywanie tekstow i dostep do nich jako widokow StrView
+// - Wsadowe odpowiedniki przeksztalcen z strutils.h, wykonywane jednym liniowym przebiegiem
+//   po calej kolumnie (z kompaktowaniem w miejscu, gdy teksty sie skracaja)
+//
+// Uwagi projektowe:
+// * Widoki zwracane przez At() traca waznosc po kazdej modyfikacji kolumny.
+// * Przeksztalcenia niezalezne od granic tekstow (zmiana wielkosci liter, podmiana znakow)
+//   wykonywane sa jednym wywolaniem jadra na calym buforze.
+//
+
+class StringColumn
+{
+public:
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie pustej kolumny.
+    //
+    StringColumn() : offsets_(1, 0) {}
+
+    //---------------------------------------------------------------------------------------------
+    // Rezerwacja miejsca na <count> tekstow o lacznej dlugosci <bytes> znakow.
+    //
+    void Reserve(cardinal count, cardinal bytes)
+    {
+        offsets_.reserve(count + 1);
+        bytes_.reserve(bytes);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Usuniecie wszystkich tekstow (zarezerwowana pamiec pozostaje do ponownego uzycia).
+    //
+    void Clear()
+    {
+        bytes_.clear();
+        offsets_.resize(1);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Dopisanie tekstu na koniec kolumny.
+    //
+    void Append(StrView str)
+    {
+        bytes_.append(str.data(), str.size());
+        offsets_.push_back(bytes_.size());
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Liczba tekstow w kolumnie / laczna liczba znakow wszystkich tekstow.
+    //
+    cardinal Count() const { return offsets_.size() -1; }
+    cardinal Bytes() const { return bytes_.size(); }
+    bool Empty() const { return Count() == 0; }
+
+    //---------------------------------------------------------------------------------------------
+    // Widok na <i>-ty tekst kolumny (bez kopiowania).
+    //
+    StrView At(cardinal i) const
+    {
+        return StrView(bytes_.data() + offsets_[i], offsets_[i +1] - offsets_[i]);
+    }
+
+    StrView operator[](cardinal i) const { return At(i); }
+
+    //---------------------------------------------------------------------------------------------
+    // Kopia <i>-tego tekstu kolumny.
+    //
+    string GetStr(cardinal i) const
+    {
+        return bytes_.substr(offsets_[i], offsets_[i +1] - offsets_[i]);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Zamiana we wszystkich tekstach wielkich liter ASCII na male.
+    //
+    void MakeLowercase()
+    {
+        if (!bytes_.empty())
+            AsciiLowercaseBlock(&bytes_[0], bytes_.size());
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Zamiana we wszystkich tekstach malych liter ASCII na wielkie.
+    //
+    void MakeUppercase()
+    {
+        if (!bytes_.empty())
+            AsciiUppercaseBlock(&bytes_[0], bytes_.size());
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Zastosowanie wybranego stylu literowego do kazdego tekstu (jak ApplyLetterCase()).
+    //
+    void ApplyLetterCase(LetterCase style)
+    {
+        // W zaleznosci od wybranego stylu ...
+        switch (style)
+        {
+            case Uppercase:
+                MakeUppercase();
+                break;
+
+            case Lowercase:
+                MakeLowercase();
+                break;
+
+            case Capitalize:
+                // ... obnizenie liter w calym buforze naraz, ...
+                MakeLowercase();
+                // ... i podniesienie pierwszego znaku kazdego niepustego tekstu
+                for (cardinal i = 0; i < Count(); i++) {
+                    if (offsets_[i] < offsets_[i +1])
+                        bytes_[offsets_[i]] = ToUpperAlpha(bytes_[offsets_[i]]);
+                }
+                break;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Zamiana we wszystkich tekstach wystapien znaku <from> na <to>.
+    //
+    void ReplaceCharInPlace(char from, char to)
+    {
+        if (from == to || bytes_.empty()) return;
+
+        ReplaceCharBlock(&bytes_[0], bytes_.size(), from, to);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Usuniecie ze wszystkich tekstow wystapien danego znaku.
+    //
+    void RemoveCharInPlace(char ch)
+    {
+        RemoveSetOfCharsInPlace(CharSet(&ch, 1));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Usuniecie ze wszystkich tekstow wystapien znakow nalezacych do zbioru <charset>.
+    // Jeden przebieg po kolumnie: kazdy tekst jest kompaktowany od razu na swoje nowe miejsce.
+    //
+    void RemoveSetOfCharsInPlace(const CharSet& charset)
+    {
+        if (charset.Empty() || bytes_.empty()) return;
+
+        char* p = &bytes_[0];
+        cardinal b = 0, j = 0;
+        // Iteracja po tekstach kolumny ...
+        for (cardinal i = 0; i < Count(); i++) {
+            // ... z przepisaniem pozostawionych znakow pod biezaca pozycje zapisu ...
+            const cardinal e = offsets_[i +1];
+            j += RemoveCharsCopyBlock(p + b, e - b, p + j, charset);
+            // ... i zapamietaniem nowego przesuniecia konca tekstu (stary koniec = nastepny poczatek)
+            offsets_[i +1] = j;
+            b = e;
+        }
+        bytes_.resize(j);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Usuniecie bialych znakow z obu stron kazdego tekstu (jak TrimStrInPlace()).
+    //
+    void TrimStrInPlace()
+    {
+        if (bytes_.empty()) return;
+
+        char* p = &bytes_[0];
+        cardinal b = 0, j = 0;
+        // Iteracja po tekstach kolumny ...
+        for (cardinal i = 0; i < Count(); i++) {
+            // ... wyznaczenie oczyszczonego fragmentu i dosuniecie go pod pozycje zapisu
+            const cardinal e = offsets_[i +1];
+            const StrView view = TrimView(StrView(p + b, e - b));
+            if (!view.empty())
+                memmove(p + j, view.data(), view.size());
+            j += view.size();
+            offsets_[i +1] = j;
+            b = e;
+        }
+        bytes_.resize(j);
+    }
+
+private:
+    string bytes_;                    // tresc wszystkich tekstow, jeden za drugim
+    std::vector<cardinal> offsets_;   // poczatki tekstow (Count() + 1 elementow, ostatni = Bytes())
+};
+
+
+} // namespace cans
+
+
+#endif // CA_STRCOLUMN_H
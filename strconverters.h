@@ -6,26 +6,41 @@
 //
 // C++ / STL
 //   <cstdio>     -> snprintf()
-//   <cstdlib>    -> strtol(), strtod()
-//   <cerrno>     -> errno, ERANGE
-//   <climits>    -> INT_MIN, INT_MAX
-//   <cmath>      -> isfinite()
+//   <climits>    -> INT_MAX, LLONG_MAX
 //   <string>     -> std::string
 //
 // Repository
-//   "numutils.h" -> cardinal, ClampInt()
+//   "numutils.h" -> cardinal, CA_CONSTEXPR, TParseResult, MakeParseResult(), IsParsedWhole()
+//   "intformat.h"-> kIntCharsMax, IntToChars(), Int64ToChars(), UIntToChars(), UInt64ToChars(),
+//                   IntCharsGenerator
+//   "dblformat.h"-> kDblCharsMax, DblToChars(), kDblFixedCharsMax, DblToCharsFixed()
+//   "intparse.h" -> ScanDecimalInt(), ScanDecimalUInt()
+//   "dblparse.h" -> ScanDecimalDbl()
 //   "strutils.h" -> IsAsciiUpperAlpha(), ReplaceCharInPlace()
+//   "strview.h"  -> StrView
+//   "fixedstr.h" -> FixedStr, MakeFixedStr()
+//   "alphalabels.h" -> ALPHA_MAX, kAlphaCharsMax, AlphaCharsGenerator
+//   "radix.h"    -> kRadixCharsMax, XxxToCharsRadix(), ParseRadixInt(), ParseRadixUInt(),
+//                   HexEncode(), HexDecode()
+//   "romannum.h" -> ROMAN_MAX, kRomanCharsMax, IntToRomanChars(), ScanRomanChars(),
+//                   RomanCharsGenerator
 //
 
 #include <cstdio>
-#include <cstdlib>
-#include <cerrno>
 #include <climits>
-#include <cmath>
 #include <string>
 
 #include "numutils.h"
+#include "intformat.h"
+#include "dblformat.h"
+#include "intparse.h"
+#include "dblparse.h"
 #include "strutils.h"
+#include "strview.h"
+#include "fixedstr.h"
+#include "alphalabels.h"
+#include "radix.h"
+#include "romannum.h"
 
 
 
@@ -51,102 +66,319 @@ namespace cans
 
 //-------------------------------------------------------------------------------------------------
 // Konwersja liczby calkowitej na tekst.
+// Formatowanie bez snprintf() i ustawien lokalnych - patrz intformat.h.
 //
 inline string IntToStr(int value)
 {
-    const cardinal kSize = 24;
-    // Alokacja bufora wynikowego
-    char bufsz[kSize] = { 0 };
+    // Bufor roboczy (na stosie) ...
+    char buf[kIntCharsMax];
+    // ... konwersja podanej liczby na ciag cyfr ...
+    char* e = IntToChars(value, buf);
 
-    // Konwersja podanej liczby na lancuch znakow
-    snprintf(bufsz, kSize, "%d", value);
-    // Wpisanie terminatora na krancu bufora (funkcja snprintf moze czasem nie domknac lancucha)
-    bufsz[kSize -1] = '\0';
+    // ... i zwrocenie tekstu wynikowego
+    return string(buf, static_cast<cardinal>(e - buf));
+}
 
-    // Zwrocenie tekstu wynikowego
-    return string(bufsz);
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej 64-bit na tekst.
+//
+inline string Int64ToStr(long long value)
+{
+    char buf[kIntCharsMax];
+    char* e = Int64ToChars(value, buf);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej bez znaku na tekst.
+//
+inline string UIntToStr(unsigned value)
+{
+    char buf[kIntCharsMax];
+    char* e = UIntToChars(value, buf);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej bez znaku 64-bit na tekst.
+//
+inline string UInt64ToStr(unsigned long long value)
+{
+    char buf[kIntCharsMax];
+    char* e = UInt64ToChars(value, buf);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej na tekst o stalej pojemnosci - mozliwa w czasie kompilacji, np.:
+//   constexpr FixedStr<kIntCharsMax> kLimit = IntToFixedStr(-2147483647 - 1);
+// W czasie wykonania szybsze jest IntToStr() / IntToChars().
+//
+CA_CONSTEXPR FixedStr<kIntCharsMax> IntToFixedStr(long long value)
+{
+    return MakeFixedStr<kIntCharsMax>(IntCharsGenerator{
+        value < 0, value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                             : static_cast<unsigned long long>(value) });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej bez znaku 64-bit na tekst o stalej pojemnosci (jak IntToFixedStr).
+//
+CA_CONSTEXPR FixedStr<kIntCharsMax> UInt64ToFixedStr(unsigned long long value)
+{
+    return MakeFixedStr<kIntCharsMax>(IntCharsGenerator{ false, value });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby calkowitej [+-]?[0-9]+ z poczatku zakresu znakow [first, last) (bez terminatora,
+// bez errno, bez wiodacych bialych znakow). Zwraca wskaznik za liczba i status: ParseInvalid
+// (brak liczby), ParseOutOfRange (wartosc nie miesci sie w typie docelowym) lub ParseOk.
+// Wartosc oddawana przez referencje zmieniana jest tylko dla ParseOk.
+//
+inline TParseResult StrToInt(const char* first, const char* last, int& out)
+{
+    long long v;
+    const TParseResult result = ScanDecimalInt(first, last, static_cast<uint64_t>(INT_MAX), v);
+    if (result.error == ParseOk) out = static_cast<int>(v);
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby calkowitej 64-bit z poczatku zakresu znakow (jak StrToInt).
+//
+inline TParseResult StrToInt64(const char* first, const char* last, long long& out)
+{
+    return ScanDecimalInt(first, last, static_cast<uint64_t>(LLONG_MAX), out);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby calkowitej bez znaku 32-bit [+]?[0-9]+ z poczatku zakresu znakow (znak '-'
+// oznacza brak liczby, takze dla "-0").
+//
+inline TParseResult StrToUInt32(const char* first, const char* last, unsigned& out)
+{
+    uint64_t v;
+    const TParseResult result = ScanDecimalUInt(first, last, 0xFFFFFFFFULL, v);
+    if (result.error == ParseOk) out = static_cast<unsigned>(v);
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby calkowitej bez znaku 64-bit z poczatku zakresu znakow (jak StrToUInt32).
+//
+inline TParseResult StrToUInt64(const char* first, const char* last, unsigned long long& out)
+{
+    uint64_t v;
+    const TParseResult result = ScanDecimalUInt(first, last, 0xFFFFFFFFFFFFFFFFULL, v);
+    if (result.error == ParseOk) out = static_cast<unsigned long long>(v);
+    return result;
 }
 
 
 //-------------------------------------------------------------------------------------------------
 // Konwersja tekstu na liczbe calkowita.
 // Uwaga: Funkcja niskopoziomowa - wykonuje bardzo ograniczona walidacje tekstu wejsciowego.
-//        Oczekuje znakow: [+-]?[0-9] i nic poza tym.
-//        Jesli ciag znakow jest niepoprawny, funkcja zwraca false i oddaje przez referencje
-//        nieokreslona wartosc.
-//
-inline bool StrToInt(const string& input, int& out)
-{
-    // Jezeli brak tresci, zakonczenie negatywne
-    if (input.empty()) return false;
-
-    const char* b = input.c_str();
-    char* e = NULL;
-    errno = 0;
-    // Konwersja tekstu na liczbe calkowita
-    const long v = ::strtol(b, &e, 10);
-    // Po konwersji:
-    // - wskaznik poczatku i konca musza roznic sie 
-    // - koncowy znak musi byc terminatorem
-    // - funkcja strtol nie powinna zwrocic blednu w errno (np. over-/-underflow zakresu long)
-    // Jezeli cos z ww. poszlo nie tak, zakonczenie negatywne
-    if ((e == b) || (*e != '\0') || (errno == ERANGE)) return false;
-
-    // Jezeli wynik konwersji nie miesci sie w docelowym typie int, zakonczenie negatywne
-    if (v < (long)INT_MIN || (long)INT_MAX < v) return false;
+//        Oczekuje znakow: [+-]?[0-9]+ i nic poza tym (takze bez wiodacych bialych znakow).
+//        Jesli ciag znakow jest niepoprawny lub wartosc nie miesci sie w typie docelowym,
+//        funkcja zwraca false i nie zmienia wartosci oddawanej przez referencje.
+//
+inline bool StrToInt(StrView input, int& out)
+{
+    const char* last = input.data() + input.size();
+    int v;
+    if (!IsParsedWhole(StrToInt(input.data(), last, v), last)) return false;
 
-    out = static_cast<int>(v);
-    // Oddanie wyniku przez referencje i zakonczenie pozytywne
+    out = v;
     return true;
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Konwersja tekstu na liczbe calkowita 64-bit (jak StrToInt).
+//
+inline bool StrToInt64(StrView input, long long& out)
+{
+    const char* last = input.data() + input.size();
+    long long v;
+    if (!IsParsedWhole(StrToInt64(input.data(), last, v), last)) return false;
+
+    out = v;
+    return true;
+}
 
 
 //-------------------------------------------------------------------------------------------------
-// Konwersja liczby rzeczywistej na tekst.
-// Wynik w formacie round-trip z 17 cyframi znaczacymi, a wiec zasadniczo notacja ogolna,
-// ale przy duzym wykladniku nastepuje samoczynna zmiana na notacje wykladnicza.
+// Konwersja tekstu na liczbe calkowita bez znaku 32-bit.
+// Oczekuje znakow: [+]?[0-9]+ i nic poza tym (znak '-' jest bledem, takze dla "-0").
 //
-inline string DblToStr(double value)
+inline bool StrToUInt32(StrView input, unsigned& out)
 {
-    const cardinal kSize = 32;
-    // Alokacja bufora wynikowego
-    char bufsz[kSize] = { 0 };
+    const char* last = input.data() + input.size();
+    unsigned v;
+    if (!IsParsedWhole(StrToUInt32(input.data(), last, v), last)) return false;
 
-    // Konwersja podanej liczby na lancuch znakow (format z 17 cyframi znaczacymi)
-    snprintf(bufsz, kSize, "%.17g", value);
-    // Wpisanie terminatora na krancu bufora (funkcja snprintf moze czasem nie domknac lancucha)
-    bufsz[kSize -1] = '\0';
+    out = v;
+    return true;
+}
 
-    string str(bufsz);
-    // Gdyby ustawienia lokalne daly przecinek, podmiana na kropke
-    ReplaceCharInPlace(str, ',', '.');
 
-    // Zwrocenie tekstu wynikowego
+//-------------------------------------------------------------------------------------------------
+// Konwersja tekstu na liczbe calkowita bez znaku 64-bit (jak StrToUInt32).
+//
+inline bool StrToUInt64(StrView input, unsigned long long& out)
+{
+    const char* last = input.data() + input.size();
+    unsigned long long v;
+    if (!IsParsedWhole(StrToUInt64(input.data(), last, v), last)) return false;
+
+    out = v;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja liczby calkowitej na tekst w podstawie <base> (2..36; cyfry 0-9, a-z lub A-Z).
+// Dla podstawy spoza zakresu zwracany jest pusty tekst.
+//
+inline string IntToStrRadix(int value, int base, bool uppercase = false)
+{
+    char buf[kRadixCharsMax];
+    char* e = IntToCharsRadix(value, base, buf, uppercase);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
+
+inline string Int64ToStrRadix(long long value, int base, bool uppercase = false)
+{
+    char buf[kRadixCharsMax];
+    char* e = Int64ToCharsRadix(value, base, buf, uppercase);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
+
+inline string UIntToStrRadix(unsigned value, int base, bool uppercase = false)
+{
+    char buf[kRadixCharsMax];
+    char* e = UIntToCharsRadix(value, base, buf, uppercase);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
+
+inline string UInt64ToStrRadix(unsigned long long value, int base, bool uppercase = false)
+{
+    char buf[kRadixCharsMax];
+    char* e = UInt64ToCharsRadix(value, base, buf, uppercase);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja tekstu w podstawie <base> (2..36, wielkosc liter bez znaczenia) na liczbe calkowita.
+// Zasady jak dla StrToInt() / StrToUInt32() itd.: [+-]?cyfry i nic poza tym (bez "0x"),
+// przekroczenie zakresu typu jest bledem; w razie bledu wartosc <out> nie jest zmieniana.
+//
+inline bool StrToIntRadix(StrView input, int base, int& out)
+{
+    long long v;
+    if (!ParseRadixInt(input.data(), input.size(), base, static_cast<uint64_t>(INT_MAX), v)) return false;
+
+    out = static_cast<int>(v);
+    return true;
+}
+
+inline bool StrToInt64Radix(StrView input, int base, long long& out)
+{
+    return ParseRadixInt(input.data(), input.size(), base, static_cast<uint64_t>(LLONG_MAX), out);
+}
+
+inline bool StrToUInt32Radix(StrView input, int base, unsigned& out)
+{
+    uint64_t v;
+    if (!ParseRadixUInt(input.data(), input.size(), base, 0xFFFFFFFFULL, v)) return false;
+
+    out = static_cast<unsigned>(v);
+    return true;
+}
+
+inline bool StrToUInt64Radix(StrView input, int base, unsigned long long& out)
+{
+    uint64_t v;
+    if (!ParseRadixUInt(input.data(), input.size(), base, 0xFFFFFFFFFFFFFFFFULL, v)) return false;
+
+    out = static_cast<unsigned long long>(v);
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis bajtow tekstu <bytes> jako cyfr szesnastkowych (2 znaki na bajt).
+//
+inline string BytesToHexStr(StrView bytes, bool uppercase = false)
+{
+    string str(2 * bytes.size(), '\0');
+    if (!bytes.empty()) HexEncode(bytes.data(), bytes.size(), &str[0], uppercase);
     return str;
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Odczyt cyfr szesnastkowych <hex> jako bajtow. Zwraca false dla nieparzystej liczby znakow
+// lub znaku spoza [0-9a-fA-F] (<out> pozostaje wtedy bez zmian).
+//
+inline bool HexStrToBytes(StrView hex, string& out)
+{
+    if (hex.size() % 2 != 0) return false;
+
+    string bytes(hex.size() / 2, '\0');
+    if (!bytes.empty() && !HexDecode(hex.data(), hex.size(), reinterpret_cast<unsigned char*>(&bytes[0])))
+        return false;
+
+    out.swap(bytes);
+    return true;
+}
+
+
+
+
+// Formaty tekstu DblToStr()
+enum DblFormat
+{
+    DblShortest,   // najkrotszy zapis round-trip, np. 0.1 -> "0.1" (dblformat.h)
+    DblDigits17    // 17 cyfr znaczacych, zgodnie z "%.17g", np. 0.1 -> "0.10000000000000001"
+};
+
+
 //-------------------------------------------------------------------------------------------------
 // Konwersja liczby rzeczywistej na tekst.
-// Wynik w formacie fixed z podana liczba miejsc dziesietnych.
+// Wynik w formacie round-trip, a wiec zasadniczo notacja ogolna, ale przy duzym wykladniku
+// nastepuje samoczynna zmiana na notacje wykladnicza. Domyslnie zapis najkrotszy (bez
+// snprintf() i ustawien lokalnych); DblDigits17 daje wynik identyczny z wczesniejszym "%.17g".
 //
-inline string DblToStrFixed(double value, short decimals = 8)
+inline string DblToStr(double value, DblFormat format = DblShortest)
 {
-    const cardinal kSize = 128;
+    if (format == DblShortest) {
+        char buf[kDblCharsMax];
+        char* e = DblToChars(value, buf);
+        return string(buf, static_cast<cardinal>(e - buf));
+    }
+
+    const cardinal kSize = 32;
     // Alokacja bufora wynikowego
     char bufsz[kSize] = { 0 };
 
-    // Auto-korekta blednie podanej precyzji
-    ClampInt(decimals, 0, 16);
-    // Konwersja podanej liczby na lancuch znakow (format z zadana liczba miejsc dziesietnych)
-    snprintf(bufsz, kSize, "%.*f", decimals, value);
+    // Konwersja podanej liczby na lancuch znakow (format z 17 cyframi znaczacymi)
+    snprintf(bufsz, kSize, "%.17g", value);
     // Wpisanie terminatora na krancu bufora (funkcja snprintf moze czasem nie domknac lancucha)
     bufsz[kSize -1] = '\0';
 
     string str(bufsz);
-    // Gdy ustawienia lokalne daly przecinek, podmiana na kropke
+    // Gdyby ustawienia lokalne daly przecinek, podmiana na kropke
     ReplaceCharInPlace(str, ',', '.');
 
     // Zwrocenie tekstu wynikowego
@@ -155,27 +387,28 @@ inline string DblToStrFixed(double value, short decimals = 8)
 
 
 //-------------------------------------------------------------------------------------------------
-// Helper: isFinite dla C++98
+// Konwersja liczby rzeczywistej na tekst.
+// Wynik w formacie fixed z podana liczba miejsc dziesietnych (przycieta do [0..16]); polowki
+// zaokraglane wg <rounding> (domyslnie do parzystej, jak printf).
 //
-static bool IsFiniteDbl(double value)
+inline string DblToStrFixed(double value, short decimals = 8, DblRounding rounding = DblHalfEven)
 {
-#if defined(_MSC_VER)
-    // MSVC (stare i nowe) ma _finite
-    return _finite(value) != 0;
+    char buf[kDblFixedCharsMax];
+    char* e = DblToCharsFixed(value, decimals, buf, rounding);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
 
-#elif defined(__GNUC__) || defined(__clang__)
-    // GCC/Clang zwykle maja isfinite jako makro/funkcje w cmath/math.h
-    return std::isfinite(value);
-#else
-    // Fallback: wykrycie NaN i +-Inf w sposob uniwersalny
-    // NaN: (v != v)
-    if (value != value) return false;
 
-    // INFO: Dla wielu platform dziala porownanie z ogromna wartoscia, ale to jest przyblizenie.
-    //       Jesli platforma nie ma isfinite/_finite, to zwykle i tak system to przyjmie.
-    const double BIG = 1.0E308;
-    return (v > -BIG && value < BIG);
-#endif
+//-------------------------------------------------------------------------------------------------
+// Odczyt liczby rzeczywistej [+-]?(digits)?(.digits)?([eE][+-]?digits)? z poczatku zakresu znakow
+// [first, last) (bez terminatora, bez ustawien lokalnych). Marker wykladnika bez cyfr nie
+// nalezy do liczby. Zwraca wskaznik za liczba i status: ParseInvalid (brak liczby),
+// ParseOutOfRange (wynik poza zakresem liczb znormalizowanych double) lub ParseOk.
+// Wartosc oddawana przez referencje zmieniana jest tylko dla ParseOk.
+//
+inline TParseResult StrToDbl(const char* first, const char* last, double& out, char decimalPoint = '.')
+{
+    return ScanDecimalDbl(first, last, out, decimalPoint);
 }
 
 
@@ -183,42 +416,24 @@ static bool IsFiniteDbl(double value)
 // Konwersja tekstu na liczbe rzeczywista.
 // Uwaga: Funkcja niskopoziomowa - wykonuje bardzo ograniczona walidacje tekstu wejsciowego.
 //        Oczekuje znakow:  [+-]?(digits)?(.digits)?([eE][+-]?digits)? i nic poza tym.
-//        Jesli ciag znakow jest niepoprawny, funkcja zwraca false i oddaje przez referencje
-//        nieokreslona wartosc.
-//
-inline bool StrToDbl(const string& input, double& out)
-{
-    // Jezeli brak tresci, zakonczenie negatywne
-    if (input.empty()) return false;
-
-    const char* b = input.c_str();
-    char* e = NULL;
-    errno = 0;
-    // Konwersja tekstu na liczbe rzeczywista
-    const double v = strtod(b, &e);
-    // Po konwersji:
-    // - wskaznik poczatku i konca musza roznic sie 
-    // - koncowy znak musi byc terminatorem
-    // - funkcja strtod nie powinna zwrocic blednu w errno (np. over-/-underflow zakresu double)
-    // Jezeli cos poszlo nie tak, zakonczenie z bledem
-    if ((e == b) || (*e != '\0') || (errno == ERANGE)) return false;
-
-#if defined(_MSC_VER)
-    // Dodatkowa ochrona: odrzucenie +/-inf (np. po overflow).
-    if (!IsFiniteDbl(v)) return false;
-#endif
+//        Separatorem dziesietnym jest <decimalPoint> (kropka lub np. przecinek), niezaleznie
+//        od ustawien lokalnych. Wynik jest poprawnie zaokraglony (jak strtod).
+//        Jesli ciag znakow jest niepoprawny lub wartosc wykracza poza zakres liczb
+//        znormalizowanych double, funkcja zwraca false i nie zmienia <out>.
+//
+inline bool StrToDbl(StrView input, double& out, char decimalPoint = '.')
+{
+    const char* last = input.data() + input.size();
+    double v;
+    if (!IsParsedWhole(ScanDecimalDbl(input.data(), last, v, decimalPoint), last)) return false;
 
     out = v;
-    // Oddanie wyniku przez referencje i zakonczenie pozytywne
     return true;
 }
 
 
 
 
-#define ALPHA_MAX 321272406  // gorna granica numeracji literowej ("ZZZZZZ")
-
-
 //-------------------------------------------------------------------------------------------------
 // Konwersja indeksu 1-based na tekst numeracji literowej pozycyjnej.
 // Jest to typowy "bijective base-26 system", czyli pozycyjny system o podstawie 26, z alfabetem
@@ -251,173 +466,118 @@ inline string IntToAlphaNumStr(int value)
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Konwersja indeksu 1-based na tekst numeracji literowej o stalej pojemnosci - mozliwa w czasie
+// kompilacji (pusty tekst dla wartosci spoza zakresu), np. stala tablica naglowkow kolumn:
+//   static constexpr FixedStr<kAlphaCharsMax> kColumns[] = { IntToAlphaNumFixedStr(1), ... };
+//
+CA_CONSTEXPR FixedStr<kAlphaCharsMax> IntToAlphaNumFixedStr(int value)
+{
+    return MakeFixedStr<kAlphaCharsMax>(AlphaCharsGenerator{
+        (value < 1 || ALPHA_MAX < value) ? 0u : static_cast<unsigned>(value) });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt tekstu numeracji literowej pozycyjnej (litery ASCII [A-Z]) z poczatku zakresu znakow
+// [first, last) jako indeksu 1-based. Odczyt obejmuje wszystkie kolejne litery; wiecej niz
+// kAlphaCharsMax liter to wartosc spoza zakresu [1..ALPHA_MAX] (ParseOutOfRange).
+// Zwraca wskaznik za tekstem i status; wartosc oddawana przez referencje zmieniana jest tylko
+// dla ParseOk.
+//
+inline TParseResult AlphaNumStrToInt(const char* first, const char* last, int& out)
+{
+    const char* p = first;
+    int v = 0;
+    // Poczawszy od 'cyfry' najstarszej: wynik = wynik * 26 + wartosc pozycyjna znaku
+    // (co najwyzej kAlphaCharsMax liter - wynik miesci sie w 32 bitach)
+    for (; p < last && IsAsciiUpperAlpha(*p); p++) {
+        if (p - first == static_cast<int>(kAlphaCharsMax)) break;
+        v = v * 26 + static_cast<int>((*p - 'A') + 1);
+    }
+    if (p == first) return MakeParseResult(first, ParseInvalid);
+
+    // Nadmiarowe litery - wartosc poza zakresem
+    if (p < last && IsAsciiUpperAlpha(*p)) {
+        while (p < last && IsAsciiUpperAlpha(*p)) p++;
+        return MakeParseResult(p, ParseOutOfRange);
+    }
+
+    out = v;
+    return MakeParseResult(p, ParseOk);
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Konwersja tekstu numeracji literowej pozycyjnej na indeks 1-based.
 // Jest to typowy "bijective base-26 system", czyli pozycyjny system o podstawie 26, z alfabetem
 // od 'A' do 'Z'. Zakres obslugiwanej numeracji to: ["A".."ZZZZZZ"] co odpowiada [1..321272406].
 // Uwaga: Funkcja niskopoziomowa! Wykonuje bardzo ograniczona walidacje tekstu wejsciowego.
 //        Dopuszczalne sa tylko znaki ASCII [A-Z]. Jesli dane sa bledne (lub ich brak),
-//        funkcja zwraca false a wartosc oddawana przez referencje jest nieokreslona.
-//
-inline bool AlphaNumStrToInt(const string& input, int& out)
-{
-    // Ustalenie liczby znakow w podanym tekscie, ...
-    cardinal n = input.size();
-    // ... jesli brak, zakonczenie negatywne
-    if (n == 0) return false;
-
-    // Jezeli ilosc znakow jest nadmierna, zakonczenie negatywne
-    // (mitygacja ryzyka przekroczenia 32-bit wyniku)
-    if (n > 6) return false;
-
-    out = 0;
-
-    int weight = 1;
-    // Poczawszy od 'cyfry' najmlodszej o wadze 1 (znak na koncu tekstu wejsciowego),
-    // iterowanie po znakach tekstu ...
-    for (; n > 0; n--)
-    {
-        // ... pobranie znaku, ...
-        const char ch = input[n -1];
-        // ... jezeli wykracza on poza alfabet systemu [A-Z], zakonczenie negatywne
-        if (!IsAsciiUpperAlpha(ch)) return false;
-
-        // ... jesli Ok, wyliczenie wartosci pozycyjnej znaku i doliczenie go do wyniku, ...
-        out += static_cast<int>((ch - 'A') +1) * weight;
-        // ... obliczenie wagi nastepnej pozycji systemu
-        weight *= 26;
-    }
+//        funkcja zwraca false i nie zmienia wartosci oddawanej przez referencje.
+//
+inline bool AlphaNumStrToInt(StrView input, int& out)
+{
+    const char* last = input.data() + input.size();
+    int v;
+    if (!IsParsedWhole(AlphaNumStrToInt(input.data(), last, v), last)) return false;
 
-    // Oddanie wyniku przez referencje i zakonczenie pozytywne
+    out = v;
     return true;
 }
 
 
 
 
-#define ROMAN_MAX 3999   // gorna granica numeracji rzymskiej ("MMMCMXCIX")
-
-
 //-------------------------------------------------------------------------------------------------
-// Liczba rzymska
+// Konwersja indeksu 1-based na tekst numeracji rzymskiej (pusty tekst dla wartosci spoza
+// zakresu 1..ROMAN_MAX).
 //
-struct TRomanNumber
+inline string IntToRomanNumStr(int value)
 {
-    const char* symbol;
-    const short value;
-
-    // Porownuje biezacy fragment lancucha tekstowego z symbolem liczby. Gdy sa zgodne - przesuwa
-    // wskaznik na kolejny fragment i zwraca true. Jesli nie - niczego nie zmienia i zwraca false.
-    bool AdvanceIfMatches(const char*& text) const 
-    {
-        cardinal i = 0;
-        // Iterowanie po znakach symbolu (aby porownac go z biezacym fragmentem lancucha) ...
-        for (; symbol[i] != '\0'; i++) {
-            // ... jezeli lancuch skonczyl sie wczesniej niz symbol, zakonczenie negatywne
-            if (text[i] == '\0') return false;
-            // ... jezeli biezacy znak lancucha nie pasuje, zakonczenie negatywne
-            if (text[i] != symbol[i]) return false;
-        }
-        // Jest zgodnosc, wiec przesuniecie wskaznika na kolejny fragment
-        text += i;
-        // Oddanie wskaznika przez referencje i zakonczenie pozytywne
-        return true;
-    }
-};
+    char buf[kRomanCharsMax];
+    char* e = IntToRomanChars(value, buf);
+    return string(buf, static_cast<cardinal>(e - buf));
+}
 
 
 //-------------------------------------------------------------------------------------------------
-// Tablica liczb rzymskich.
-// Elementy celowo ulozone w kolejnosci malejacej - porzadek pod konwersje algorytmem "zachlannym".
+// Konwersja indeksu 1-based na tekst numeracji rzymskiej o stalej pojemnosci - mozliwa w czasie
+// kompilacji (pusty tekst dla wartosci spoza zakresu 1..ROMAN_MAX).
 //
-static const TRomanNumber kRomanNumbers[] =
+CA_CONSTEXPR FixedStr<kRomanCharsMax> IntToRomanNumFixedStr(int value)
 {
-    {"M", 1000}, {"CM", 900}, {"D", 500}, {"CD", 400},
-    {"C", 100},  {"XC", 90},  {"L", 50},  {"XL", 40},
-    {"X", 10},   {"IX", 9},   {"V", 5},   {"IV", 4},
-    {"I", 1}
-};
-const cardinal kRomanCount = 13;
+    return MakeFixedStr<kRomanCharsMax>(RomanCharsGenerator{
+        (value < 1 || ROMAN_MAX < value) ? 0u : static_cast<unsigned>(value) });
+}
 
 
 //-------------------------------------------------------------------------------------------------
-// Konwersja indeksu 1-based na tekst numeracji rzymskiej.
+// Odczyt najdluzszego kanonicznego zapisu rzymskiego z poczatku zakresu znakow [first, last)
+// jako indeksu 1-based (np. dla "XIIII" odczytane zostaje "XIII"). Zwraca wskaznik za zapisem
+// i status (ParseInvalid - brak zapisu); wartosc oddawana przez referencje zmieniana jest tylko
+// dla ParseOk.
 //
-inline string IntToRomanNumStr(int value)
+inline TParseResult RomanNumStrToInt(const char* first, const char* last, int& out)
 {
-    // Jezeli podano wartosc spoza zakresu, zwrocenie pustego wyniku
-    if (value < 1 || ROMAN_MAX < value) return string();
-    
-    const cardinal kSize = 16;
-    string str;
-    // Prealokacja tekstu wynikowego
-    str.reserve(kSize);
-
-    // Tworzenie zapisu liczby rzymskiej algorytmem "zachlannym" (wybor najwiekszych dopasowan), tj.:
-    // iterowanie po elementach z tablicy liczb rzymskich - od najwiekszej do coraz mniejszych ...
-    for (cardinal i = 0; i < kRomanCount; i++) 
-    {
-        const short rv = kRomanNumbers[i].value;
-        const char* rs = kRomanNumbers[i].symbol;
-        // ... i tak dlugo jak wybrana z tablicy liczba miesci sie w reszcie z podanej wartosci ...
-        while (rv <= value) {
-            // ... odejmowanie jej ...
-            value -= rv;
-            // ... i dopisywanie symbolu do tekstu wynikowego
-            str.append(rs);
-        }
-        // ... az do wyzerowania reszty
-        if (value == 0) break;
-    }
-
-    // Zwrocenie tekstu wynikowego
-    return str;
+    return ScanRomanChars(first, last, out);
 }
 
 
 //-------------------------------------------------------------------------------------------------
 // Konwersja tekstu numeracji rzymskiej na indeks 1-based.
-// Uwaga: Funkcja niskopoziomowa! Wykonuje bardzo ograniczona walidacje tekstu wejsciowego.
-//        Oczekuje na wejsciu: [I,V,X,L,C,D,M] i nic poza tym. 
-//        Dopuszczalne sa tylko znaki ASCII [A-Z]. Jesli dane sa bledne (lub ich brak),
-//        funkcja zwraca false a wartosc oddawana przez referencje jest nieokreslona.
-//
-inline bool RomanNumStrToInt(const string& input, int& out)
-{
-    // Ustalenie liczby znakow w podanym tekscie, ...
-    cardinal n = input.size();
-    // ... jesli brak, zakonczenie negatywne
-    if (n == 0) return false;
-
-    // Jezeli ilosc znakow jest nadmierna, zakonczenie negatywne
-    // (najdluzszy rozpoznawalny ciag to: "MMMDCCCLXXXVIII")
-    if (n > 15) return false;
-
-    out = 0;
-
-    const char* p = input.c_str();
-    // Dopoki lancuch znakow (podany tekst) nie zostanie w calosci przetworzony ...
-    while (*p) 
-    {
-        bool matches = false;
-        // ... iterowanie po elementach z tablicy liczb rzymskich ...
-        for (cardinal i = 0; i < kRomanCount; i++)
-        {
-            // ... w poszukiwaniu dopasowania symbolu liczby do wskazanego fragmentu lancucha;
-            // jezeli liczba rozpozna swoj symbol w tekscie, ...
-            if (kRomanNumbers[i].AdvanceIfMatches(p)) {
-                // ... to doliczenie jej wartosci do wyniku i zgloszenie dopasowania
-                out += kRomanNumbers[i].value;
-                matches = true;
-                break; 
-            }
-        }
-
-        // Jezeli nie udalo sie dopasowac zadnego symbolu, zakonczenie negatywne
-        if (!matches) return false;
-    }
+// Uwaga: Oczekuje na wejsciu: [I,V,X,L,C,D,M] w zapisie kanonicznym (takim, jaki daje
+//        IntToRomanNumStr()) i nic poza tym - np. "IIII" czy "IM" sa odrzucane.
+//        Jesli dane sa bledne (lub ich brak), funkcja zwraca false i nie zmienia wartosci
+//        oddawanej przez referencje.
+//
+inline bool RomanNumStrToInt(StrView input, int& out)
+{
+    const char* last = input.data() + input.size();
+    int v;
+    if (!IsParsedWhole(RomanNumStrToInt(input.data(), last, v), last)) return false;
 
-    // Oddanie wyniku przez referencje i zakonczenie pozytywne
+    out = v;
     return true;
 }
 
@@ -0,0 +1,972 @@
+#ifndef CA_STRKERNELS_H
+#define CA_STRKERNELS_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memcpy()
+//   <stdint.h>      -> uint64_t
+//
+// Platforma (tylko x86 / x86-64, o ile nie zdefiniowano CA_NO_SIMD)
+//   <emmintrin.h>   -> SSE2
+//   <immintrin.h>   -> SSSE3, AVX2
+//   <intrin.h>      -> __cpuid(), __cpuidex(), _BitScanForward64() (MSVC)
+//
+// Repository
+//   "numutils.h"    -> cardinal, CA_CONSTEXPR14
+//   "charset.h"     -> CharSet
+//
+
+#include <cstring>
+#include <stdint.h>
+
+#include "numutils.h"
+#include "charset.h"
+
+#if !defined(CA_NO_SIMD) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CA_SIMD_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Atrybuty pozwalajace skompilowac pojedyncza funkcje z SSSE3/AVX2 bez globalnych flag -mssse3
+// i -mavx2 (MSVC nie wymaga atrybutu - intrynsyki sa zawsze dostepne)
+#if defined(CA_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CA_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define CA_TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#define CA_TARGET_SSSE3
+#define CA_TARGET_AVX2
+#endif
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Jadra obliczeniowe operacji tekstowych (ASCII)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Niskopoziomowe implementacje przeksztalcen blokow bajtow w kilku wariantach: skalarnym
+//   (referencyjnym), SWAR (8 bajtow w slowie 64-bit) oraz wektorowym SSE2/SSSE3/AVX2. Wariant
+//   jest wybierany jednorazowo, przy pierwszym uzyciu, na podstawie mozliwosci procesora.
+//
+// Uwagi projektowe:
+// * Kazdy wariant daje wynik identyczny bajt w bajt z wariantem skalarnym.
+// * Jedynym stanem globalnym jest wynik detekcji procesora (statyczna stala lokalna funkcji,
+//   inicjalizowana raz i bezpiecznie watkowo).
+// * Zdefiniowanie CA_NO_SIMD wylacza warianty wektorowe (pozostaja skalarny i SWAR).
+//
+
+//-------------------------------------------------------------------------------------------------
+// Poziomy rozszerzen wektorowych procesora (uporzadkowane rosnaco)
+//
+enum SimdLevel
+{
+    SimdNone,    // tylko kod skalarny / SWAR
+    SimdSse2,    // SSE2 (bazowy dla x86-64)
+    SimdSsse3,   // SSSE3 (pshufb)
+    SimdAvx2     // AVX2
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Wykrycie najwyzszego poziomu rozszerzen wektorowych obslugiwanego przez procesor i system.
+//
+inline SimdLevel DetectSimdLevel()
+{
+#if defined(CA_SIMD_X86) && defined(_MSC_VER)
+    int info[4] = { 0 };
+    // Odczyt liczby obslugiwanych funkcji CPUID, ...
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    // ... a nastepnie flag procesora: bit 9 ECX = SSSE3, bit 27 ECX = OSXSAVE, bit 28 ECX = AVX
+    __cpuid(info, 1);
+    const bool ssse3 = (info[2] & (1 << 9)) != 0;
+    const bool osAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28))
+                       // ... z potwierdzeniem, ze system zachowuje rejestry YMM (XCR0 bity 1 i 2)
+                       && ((_xgetbv(0) & 6) == 6);
+    if (osAvx && maxLeaf >= 7) {
+        // Bit 5 EBX funkcji 7 = AVX2
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) return SimdAvx2;
+    }
+    return ssse3 ? SimdSsse3 : SimdSse2;
+
+#elif defined(CA_SIMD_X86)
+    // GCC/Clang - detekcja wbudowana (uwzglednia takze wsparcie systemu dla rejestrow YMM)
+    if (__builtin_cpu_supports("avx2")) return SimdAvx2;
+    if (__builtin_cpu_supports("ssse3")) return SimdSsse3;
+    return SimdSse2;
+
+#else
+    return SimdNone;
+#endif
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Aktywny poziom rozszerzen wektorowych (wykrywany raz, przy pierwszym wywolaniu).
+//
+inline SimdLevel ActiveSimdLevel()
+{
+    static const SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: powielenie bajtu na wszystkie pozycje slowa 64-bit (SWAR)
+//
+inline uint64_t SwarBroadcast(unsigned char b)
+{
+    return 0x0101010101010101ULL * b;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana wielkosci liter w bloku bajtow - wariant skalarny (referencyjny).
+// Znakom z zakresu [lo..hi] odwracany jest bit 0x20, co dla zakresu [A-Z] daje male litery,
+// a dla zakresu [a-z] wielkie. Pozostale bajty nie sa zmieniane.
+//
+inline void FlipCaseScalar(char* p, cardinal n, char lo, char hi)
+{
+    // Iteracja po bajtach bloku ...
+    for (cardinal i = 0; i < n; i++) {
+        // ... z odwroceniem bitu wielkosci litery dla znakow z zakresu
+        if (lo <= p[i] && p[i] <= hi)
+            p[i] ^= char(0x20);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana wielkosci liter w bloku bajtow - wariant SWAR (8 bajtow na slowo 64-bit).
+// Zakres [lo..hi] musi lezec w obszarze ASCII (0x00..0x7F).
+//
+inline void FlipCaseSwar(char* p, cardinal n, char lo, char hi)
+{
+    const uint64_t kHigh = SwarBroadcast(0x80);
+    // Stale porownan: po dodaniu do 7 mlodszych bitow bajtu, najstarszy bit jest ustawiony
+    // odpowiednio gdy bajt >= lo oraz gdy bajt > hi (sumy nie przenosza sie miedzy bajtami)
+    const uint64_t kGeLo = SwarBroadcast((unsigned char)(0x80 - lo));
+    const uint64_t kGtHi = SwarBroadcast((unsigned char)(0x7F - hi));
+
+    cardinal i = 0;
+    // Przetwarzanie pelnych slow 8-bajtowych ...
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        // ... wyznaczenie maski bajtow ASCII z zakresu [lo..hi] (na najstarszych bitach), ...
+        const uint64_t low7 = w & ~kHigh;
+        const uint64_t inRange = ((low7 + kGeLo) ^ (low7 + kGtHi)) & ~w & kHigh;
+        // ... i odwrocenie bitu 0x20 w tych bajtach
+        w ^= inRange >> 2;
+        memcpy(p + i, &w, 8);
+    }
+    // Koncowka krotsza niz slowo - wariant skalarny
+    FlipCaseScalar(p + i, n - i, lo, hi);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana wielkich liter ASCII na male w 8 bajtach slowa 64-bit (SWAR, jak ToLowerAlpha()).
+//
+inline uint64_t SwarToLower(uint64_t w)
+{
+    const uint64_t kHigh = SwarBroadcast(0x80);
+    // Stale porownan jak w FlipCaseSwar() dla zakresu [A..Z]
+    const uint64_t kGeLo = SwarBroadcast((unsigned char)(0x80 - 'A'));
+    const uint64_t kGtHi = SwarBroadcast((unsigned char)(0x7F - 'Z'));
+
+    const uint64_t low7 = w & ~kHigh;
+    const uint64_t inRange = ((low7 + kGeLo) ^ (low7 + kGtHi)) & ~w & kHigh;
+    return w ^ (inRange >> 2);
+}
+
+
+#if defined(CA_SIMD_X86)
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana wielkosci liter w bloku bajtow - wariant SSE2 (16 bajtow na iteracje).
+//
+inline void FlipCaseSse2(char* p, cardinal n, char lo, char hi)
+{
+    // Porownania ze znakiem: bajty >= 0x80 sa ujemne, wiec nigdy nie trafiaja w zakres ASCII
+    const __m128i vLo = _mm_set1_epi8(char(lo - 1));
+    const __m128i vHi = _mm_set1_epi8(char(hi + 1));
+    const __m128i vBit = _mm_set1_epi8(0x20);
+
+    cardinal i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(v, vLo), _mm_cmplt_epi8(v, vHi));
+        v = _mm_xor_si128(v, _mm_and_si128(inRange, vBit));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), v);
+    }
+    // Koncowka krotsza niz rejestr - wariant SWAR
+    FlipCaseSwar(p + i, n - i, lo, hi);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana wielkosci liter w bloku bajtow - wariant AVX2 (32 bajty na iteracje).
+//
+CA_TARGET_AVX2
+inline void FlipCaseAvx2(char* p, cardinal n, char lo, char hi)
+{
+    const __m256i vLo = _mm256_set1_epi8(char(lo - 1));
+    const __m256i vHi = _mm256_set1_epi8(char(hi + 1));
+    const __m256i vBit = _mm256_set1_epi8(0x20);
+
+    cardinal i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi8(v, vLo),
+                                                 _mm256_cmpgt_epi8(vHi, v));
+        v = _mm256_xor_si256(v, _mm256_and_si256(inRange, vBit));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), v);
+    }
+    // Koncowka krotsza niz rejestr - wariant SSE2
+    FlipCaseSse2(p + i, n - i, lo, hi);
+}
+
+#endif // CA_SIMD_X86
+
+
+typedef void (*FlipCaseKernel)(char* p, cardinal n, char lo, char hi);
+
+//-------------------------------------------------------------------------------------------------
+// Wybor wariantu jadra zamiany wielkosci liter dla biezacego procesora.
+//
+inline FlipCaseKernel SelectFlipCaseKernel(SimdLevel level)
+{
+#if defined(CA_SIMD_X86)
+    if (level >= SimdAvx2) return &FlipCaseAvx2;
+    if (level >= SimdSse2) return &FlipCaseSse2;
+#endif
+    (void)level;
+    return &FlipCaseSwar;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana w bloku bajtow wielkich liter ASCII na male (modyfikacja in-place).
+//
+inline void AsciiLowercaseBlock(char* p, cardinal n)
+{
+    static const FlipCaseKernel kernel = SelectFlipCaseKernel(ActiveSimdLevel());
+    kernel(p, n, 'A', 'Z');
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana w bloku bajtow malych liter ASCII na wielkie (modyfikacja in-place).
+//
+inline void AsciiUppercaseBlock(char* p, cardinal n)
+{
+    static const FlipCaseKernel kernel = SelectFlipCaseKernel(ActiveSimdLevel());
+    kernel(p, n, 'a', 'z');
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana w bloku bajtow wystapien znaku <from> na <to> (modyfikacja in-place).
+// Petla bez rozgalezien, ktora kompilatory wektoryzuja samodzielnie (porownanie i wybor).
+//
+inline void ReplaceCharBlock(char* p, cardinal n, char from, char to)
+{
+    for (cardinal i = 0; i < n; i++) {
+        const char ch = p[i];
+        p[i] = (ch == from) ? to : ch;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odwzorowanie bajtow bloku tablica 256 bajtow: dst[i] = map[src[i]] - wariant tablicowy.
+// Wszystkie warianty dopuszczaja dst == src oraz dst < src (zapis nie wyprzedza odczytu).
+//
+inline void TranslateTableScalar(const char* src, cardinal n, char* dst, const char* map)
+{
+    for (cardinal i = 0; i < n; i++)
+        dst[i] = map[static_cast<unsigned char>(src[i])];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odwzorowanie bajtow bloku, w ktorym tylko <k> bajtow <from> zmienia wartosc (na map[from[j]]).
+// Wariant skalarny - zwykle odwzorowanie tablicowe (<from> i <k> sluza wariantom wektorowym).
+//
+inline void TranslateSparseScalar(const char* src, cardinal n, char* dst, const char* map,
+                                  const char* from, cardinal k)
+{
+    (void)from; (void)k;
+    TranslateTableScalar(src, n, dst, map);
+}
+
+
+#if defined(CA_SIMD_X86)
+
+//-------------------------------------------------------------------------------------------------
+// Odwzorowanie nielicznych bajtow bloku - wariant SSE2 (16 bajtow na iteracje).
+// Dla kazdego zmienianego bajtu: porownanie calego rejestru i podstawienie nowej wartosci.
+// Koszt rosnie z <k>, stad wariant przeznaczony dla malych <k> (kilka - kilkanascie bajtow).
+//
+inline void TranslateSparseSse2(const char* src, cardinal n, char* dst, const char* map,
+                                const char* from, cardinal k)
+{
+    cardinal i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i r = v;
+        // Porownania z wartoscia oryginalna - kolejne podstawienia nie wplywaja na siebie
+        for (cardinal j = 0; j < k; j++) {
+            const unsigned char b = static_cast<unsigned char>(from[j]);
+            const __m128i hit = _mm_cmpeq_epi8(v, _mm_set1_epi8(from[j]));
+            r = _mm_or_si128(_mm_andnot_si128(hit, r), _mm_and_si128(hit, _mm_set1_epi8(map[b])));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+    }
+    // Koncowka krotsza niz rejestr
+    TranslateTableScalar(src + i, n - i, dst + i, map);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odwzorowanie nielicznych bajtow bloku - wariant AVX2 (32 bajty na iteracje).
+//
+CA_TARGET_AVX2
+inline void TranslateSparseAvx2(const char* src, cardinal n, char* dst, const char* map,
+                                const char* from, cardinal k)
+{
+    cardinal i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i r = v;
+        for (cardinal j = 0; j < k; j++) {
+            const unsigned char b = static_cast<unsigned char>(from[j]);
+            const __m256i hit = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(from[j]));
+            r = _mm256_blendv_epi8(r, _mm256_set1_epi8(map[b]), hit);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+    }
+    // Koncowka krotsza niz rejestr - wariant SSE2
+    TranslateSparseSse2(src + i, n - i, dst + i, map, from, k);
+}
+
+#endif // CA_SIMD_X86
+
+
+typedef void (*TranslateSparseKernel)(const char* src, cardinal n, char* dst, const char* map,
+                                      const char* from, cardinal k);
+
+//-------------------------------------------------------------------------------------------------
+// Wybor wariantu jadra odwzorowania nielicznych bajtow dla biezacego procesora.
+//
+inline TranslateSparseKernel SelectTranslateSparseKernel(SimdLevel level)
+{
+#if defined(CA_SIMD_X86)
+    if (level >= SimdAvx2) return &TranslateSparseAvx2;
+    if (level >= SimdSse2) return &TranslateSparseSse2;
+#endif
+    (void)level;
+    return &TranslateSparseScalar;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odwzorowanie bajtow bloku tablica <map>, gdy zmieniaja sie tylko bajty <from> (<k> bajtow).
+//
+inline void TranslateSparseBlock(const char* src, cardinal n, char* dst, const char* map,
+                                 const char* from, cardinal k)
+{
+    static const TranslateSparseKernel kernel = SelectTranslateSparseKernel(ActiveSimdLevel());
+    kernel(src, n, dst, map, from, k);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z bloku bajtow znakow nalezacych do zbioru - wariant skalarny (referencyjny).
+// Znaki spoza zbioru przepisywane sa z <src> do <dst>; zwracana jest ich liczba.
+// Wszystkie warianty dopuszczaja dst == src (kompaktowanie in-place), dst < src, albo osobny
+// bufor docelowy - ten jednak musi pomiescic <n> bajtow (warianty wektorowe zapisuja blokami).
+//
+inline cardinal RemoveCharsScalar(const char* src, cardinal n, char* dst, const CharSet& set)
+{
+    cardinal j = 0;
+    // Iteracja po bajtach bloku ...
+    for (cardinal i = 0; i < n; i++) {
+        // ... z przepisywaniem znakow spoza zbioru
+        if (!set.Contains(src[i]))
+            dst[j++] = src[i];
+    }
+    return j;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z bloku bajtow znakow nalezacych do zbioru - wariant bezskokowy (przenosny).
+// Kazdy bajt jest przepisywany, a pozycja zapisu przesuwana tylko dla znakow pozostawionych.
+//
+inline cardinal RemoveCharsBranchless(const char* src, cardinal n, char* dst, const CharSet& set)
+{
+    cardinal j = 0;
+    for (cardinal i = 0; i < n; i++) {
+        const char ch = src[i];
+        dst[j] = ch;
+        j += !set.Contains(ch);
+    }
+    return j;
+}
+
+
+#if defined(CA_SIMD_X86)
+
+//-------------------------------------------------------------------------------------------------
+// Tablica kompaktowania 8-bajtowych grup: dla kazdej maski bajtow pozostawionych - indeksy
+// tych bajtow (operand pshufb) oraz ich liczba. Budowana raz, przy pierwszym uzyciu.
+//
+struct TCompactTable
+{
+    unsigned char shuffle[256][8];
+    unsigned char count[256];
+
+    TCompactTable()
+    {
+        for (unsigned m = 0; m < 256; m++) {
+            unsigned char k = 0;
+            for (unsigned char b = 0; b < 8; b++) {
+                if (m & (1u << b)) shuffle[m][k++] = b;
+            }
+            count[m] = k;
+            // Pozostale pozycje zerowane przez pshufb (ustawiony najstarszy bit indeksu)
+            for (unsigned char b = k; b < 8; b++) shuffle[m][b] = 0x80;
+        }
+    }
+};
+
+inline const TCompactTable& CompactTable()
+{
+    static const TCompactTable table;
+    return table;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: maska bajtow rejestru nalezacych do zbioru (SSSE3, wyszukiwanie po polbajtach).
+//
+CA_TARGET_SSSE3
+inline __m128i MatchCharSetSsse3(__m128i v, __m128i lutLo, __m128i lutHi)
+{
+    const __m128i low4 = _mm_set1_epi8(0x0F);
+    const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    // Rozbicie bajtow na polbajty: mlodszy wybiera wiersz tablicy, starszy - bit w wierszu
+    const __m128i lo = _mm_and_si128(v, low4);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low4);
+    const __m128i isHi = _mm_cmpgt_epi8(hi, _mm_set1_epi8(7));
+    const __m128i row = _mm_or_si128(_mm_andnot_si128(isHi, _mm_shuffle_epi8(lutLo, lo)),
+                                     _mm_and_si128(isHi, _mm_shuffle_epi8(lutHi, lo)));
+    const __m128i bit = _mm_shuffle_epi8(bits, hi);
+    return _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z bloku bajtow znakow nalezacych do zbioru - wariant SSSE3 (16 bajtow na iteracje).
+// Maska przynaleznosci wyznaczana jest wektorowo, a bajty pozostawione kompaktowane pshufb
+// w dwoch grupach po 8. Zapis nigdy nie wyprzedza odczytu, wiec dzialanie in-place jest bezpieczne.
+//
+CA_TARGET_SSSE3
+inline cardinal RemoveCharsSsse3(const char* src, cardinal n, char* dst, const CharSet& set)
+{
+    const TCompactTable& table = CompactTable();
+    const __m128i lutLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.NibbleTableLo()));
+    const __m128i lutHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.NibbleTableHi()));
+    const __m128i eight = _mm_set1_epi8(8);
+
+    cardinal i = 0, j = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const unsigned keep = ~_mm_movemask_epi8(MatchCharSetSsse3(v, lutLo, lutHi)) & 0xFFFF;
+        // Blok bez znakow do usuniecia - przepisanie w calosci
+        if (keep == 0xFFFF) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j), v);
+            j += 16;
+            continue;
+        }
+        // Kompaktowanie obu polowek rejestru i zapis jedna za druga
+        const unsigned k0 = keep & 0xFF, k1 = keep >> 8;
+        const __m128i shuf = _mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.shuffle[k0])),
+            _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.shuffle[k1])), eight));
+        const __m128i c = _mm_shuffle_epi8(v, shuf);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), c);
+        j += table.count[k0];
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), _mm_srli_si128(c, 8));
+        j += table.count[k1];
+    }
+    // Koncowka krotsza niz rejestr
+    for (; i < n; i++) {
+        const char ch = src[i];
+        dst[j] = ch;
+        j += !set.Contains(ch);
+    }
+    return j;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z bloku bajtow znakow nalezacych do zbioru - wariant AVX2 (32 bajty na iteracje).
+//
+CA_TARGET_AVX2
+inline cardinal RemoveCharsAvx2(const char* src, cardinal n, char* dst, const CharSet& set)
+{
+    const TCompactTable& table = CompactTable();
+    const __m256i lutLo = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.NibbleTableLo())));
+    const __m256i lutHi = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.NibbleTableHi())));
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i eight = _mm_set1_epi8(8);
+
+    cardinal i = 0, j = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        // Maska przynaleznosci - jak w MatchCharSetSsse3(), w obu polowkach rejestru naraz
+        const __m256i lo = _mm256_and_si256(v, low4);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low4);
+        const __m256i isHi = _mm256_cmpgt_epi8(hi, _mm256_set1_epi8(7));
+        const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(lutLo, lo),
+                                               _mm256_shuffle_epi8(lutHi, lo), isHi);
+        const __m256i bit = _mm256_shuffle_epi8(bits, hi);
+        const __m256i match = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+        const unsigned keep = ~static_cast<unsigned>(_mm256_movemask_epi8(match));
+        // Blok bez znakow do usuniecia - przepisanie w calosci
+        if (keep == 0xFFFFFFFFu) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + j), v);
+            j += 32;
+            continue;
+        }
+        // Kompaktowanie czterech grup 8-bajtowych i zapis jedna za druga
+        const unsigned k[4] = { keep & 0xFF, (keep >> 8) & 0xFF, (keep >> 16) & 0xFF, keep >> 24 };
+        const __m128i shufLo = _mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.shuffle[k[0]])),
+            _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.shuffle[k[1]])), eight));
+        const __m128i shufHi = _mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.shuffle[k[2]])),
+            _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.shuffle[k[3]])), eight));
+        const __m256i c = _mm256_shuffle_epi8(
+            v, _mm256_inserti128_si256(_mm256_castsi128_si256(shufLo), shufHi, 1));
+        const __m128i cLo = _mm256_castsi256_si128(c);
+        const __m128i cHi = _mm256_extracti128_si256(c, 1);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), cLo);
+        j += table.count[k[0]];
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), _mm_srli_si128(cLo, 8));
+        j += table.count[k[1]];
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), cHi);
+        j += table.count[k[2]];
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), _mm_srli_si128(cHi, 8));
+        j += table.count[k[3]];
+    }
+    // Koncowka krotsza niz rejestr
+    for (; i < n; i++) {
+        const char ch = src[i];
+        dst[j] = ch;
+        j += !set.Contains(ch);
+    }
+    return j;
+}
+
+#endif // CA_SIMD_X86
+
+
+typedef cardinal (*RemoveCharsKernel)(const char* src, cardinal n, char* dst, const CharSet& set);
+
+//-------------------------------------------------------------------------------------------------
+// Wybor wariantu jadra usuwania znakow dla biezacego procesora.
+//
+inline RemoveCharsKernel SelectRemoveCharsKernel(SimdLevel level)
+{
+#if defined(CA_SIMD_X86)
+    if (level >= SimdAvx2)  return &RemoveCharsAvx2;
+    if (level >= SimdSsse3) return &RemoveCharsSsse3;
+#endif
+    (void)level;
+    return &RemoveCharsBranchless;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Przepisanie z bloku <src> do <dst> znakow nienalezacych do zbioru (wymagania co do <dst> -
+// jak w RemoveCharsScalar()). Zwraca liczbe przepisanych znakow.
+//
+inline cardinal RemoveCharsCopyBlock(const char* src, cardinal n, char* dst, const CharSet& set)
+{
+    static const RemoveCharsKernel kernel = SelectRemoveCharsKernel(ActiveSimdLevel());
+    return kernel(src, n, dst, set);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z bloku bajtow wszystkich znakow nalezacych do zbioru (modyfikacja in-place).
+// Zwraca nowa dlugosc bloku.
+//
+inline cardinal RemoveCharsBlock(char* p, cardinal n, const CharSet& set)
+{
+    return RemoveCharsCopyBlock(p, n, p, set);
+}
+
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: pozycja najmlodszego ustawionego bitu slowa 64-bit (<mask> nie moze byc 0).
+//
+inline cardinal LowestBitIndex(uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<cardinal>(__builtin_ctzll(mask));
+#elif defined(CA_SIMD_X86) && defined(_MSC_VER) && defined(_M_X64)
+    unsigned long k;
+    _BitScanForward64(&k, mask);
+    return static_cast<cardinal>(k);
+#else
+    cardinal k = 0;
+    while (!(mask & 1)) { mask >>= 1; k++; }
+    return k;
+#endif
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Maska przynaleznosci do zbioru dla bloku do 64 bajtow - wariant skalarny (referencyjny).
+// Bit i wyniku jest ustawiony, gdy bajt p[i] nalezy do zbioru (dla n < 64 starsze bity sa zerami).
+//
+inline uint64_t CharSetMaskScalar(const char* p, cardinal n, const CharSet& set)
+{
+    uint64_t mask = 0;
+    for (cardinal i = 0; i < n; i++)
+        mask |= static_cast<uint64_t>(set.Contains(p[i])) << i;
+    return mask;
+}
+
+
+#if defined(CA_SIMD_X86)
+
+//-------------------------------------------------------------------------------------------------
+// Maska przynaleznosci do zbioru dla bloku do 64 bajtow - wariant SSSE3 (4 rejestry 16-bajtowe).
+//
+CA_TARGET_SSSE3
+inline uint64_t CharSetMaskSsse3(const char* p, cardinal n, const CharSet& set)
+{
+    if (n < 64) return CharSetMaskScalar(p, n, set);
+
+    const __m128i lutLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.NibbleTableLo()));
+    const __m128i lutHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.NibbleTableHi()));
+    uint64_t mask = 0;
+    for (cardinal k = 0; k < 4; k++) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+        const unsigned m = _mm_movemask_epi8(MatchCharSetSsse3(v, lutLo, lutHi));
+        mask |= static_cast<uint64_t>(m) << (16 * k);
+    }
+    return mask;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Maska przynaleznosci do zbioru dla bloku do 64 bajtow - wariant AVX2 (2 rejestry 32-bajtowe).
+//
+CA_TARGET_AVX2
+inline uint64_t CharSetMaskAvx2(const char* p, cardinal n, const CharSet& set)
+{
+    if (n < 64) return CharSetMaskScalar(p, n, set);
+
+    const __m256i lutLo = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.NibbleTableLo())));
+    const __m256i lutHi = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.NibbleTableHi())));
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    uint64_t mask = 0;
+    for (cardinal k = 0; k < 2; k++) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * k));
+        // Maska przynaleznosci - jak w RemoveCharsAvx2()
+        const __m256i lo = _mm256_and_si256(v, low4);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low4);
+        const __m256i isHi = _mm256_cmpgt_epi8(hi, _mm256_set1_epi8(7));
+        const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(lutLo, lo),
+                                               _mm256_shuffle_epi8(lutHi, lo), isHi);
+        const __m256i bit = _mm256_shuffle_epi8(bits, hi);
+        const __m256i match = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(match))) << (32 * k);
+    }
+    return mask;
+}
+
+#endif // CA_SIMD_X86
+
+
+typedef uint64_t (*CharSetMaskKernel)(const char* p, cardinal n, const CharSet& set);
+
+//-------------------------------------------------------------------------------------------------
+// Wybor wariantu jadra maski przynaleznosci dla biezacego procesora.
+//
+inline CharSetMaskKernel SelectCharSetMaskKernel(SimdLevel level)
+{
+#if defined(CA_SIMD_X86)
+    if (level >= SimdAvx2)  return &CharSetMaskAvx2;
+    if (level >= SimdSsse3) return &CharSetMaskSsse3;
+#endif
+    (void)level;
+    return &CharSetMaskScalar;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Maska przynaleznosci do zbioru dla <n> (<= 64) bajtow bloku <p>: bit i = bajt p[i] w zbiorze.
+//
+inline uint64_t CharSetMaskBlock(const char* p, cardinal n, const CharSet& set)
+{
+    static const CharSetMaskKernel kernel = SelectCharSetMaskKernel(ActiveSimdLevel());
+    return kernel(p, n, set);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: wartosc cyfry szesnastkowej [0-9a-fA-F] lub 16 dla innych znakow.
+//
+CA_CONSTEXPR14 unsigned HexDigitValue(char ch)
+{
+    const unsigned c = static_cast<unsigned char>(ch);
+    if (c - '0' < 10) return c - '0';
+    const unsigned alpha = (c | 0x20) - 'a';
+    return (alpha < 6) ? alpha + 10 : 16;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis <n> bajtow <src> jako 2 * n cyfr szesnastkowych (alfabet <digits>, 16 znakow) -
+// wariant skalarny (referencyjny).
+//
+inline void HexEncodeScalar(const unsigned char* src, cardinal n, char* dst, const char* digits)
+{
+    for (cardinal i = 0; i < n; i++) {
+        dst[2 * i] = digits[src[i] >> 4];
+        dst[2 * i + 1] = digits[src[i] & 0x0F];
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt 2 * n cyfr szesnastkowych <src> jako <n> bajtow - wariant skalarny (referencyjny).
+// Zwraca false, gdy wystapi znak spoza [0-9a-fA-F] (zawartosc <dst> jest wtedy nieokreslona).
+//
+inline bool HexDecodeScalar(const char* src, cardinal n, unsigned char* dst)
+{
+    for (cardinal i = 0; i < n; i++) {
+        const unsigned hi = HexDigitValue(src[2 * i]);
+        const unsigned lo = HexDigitValue(src[2 * i + 1]);
+        if ((hi | lo) > 15) return false;
+        dst[i] = static_cast<unsigned char>((hi << 4) | lo);
+    }
+    return true;
+}
+
+
+#if defined(CA_SIMD_X86)
+
+//-------------------------------------------------------------------------------------------------
+// Zapis bajtow jako cyfr szesnastkowych - wariant SSSE3 (16 bajtow -> 32 znaki: polowki bajtow
+// zamieniane na cyfry przez pshufb i przeplatane).
+//
+CA_TARGET_SSSE3
+inline void HexEncodeSsse3(const unsigned char* src, cardinal n, char* dst, const char* digits)
+{
+    const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+    const __m128i low4 = _mm_set1_epi8(0x0F);
+    cardinal i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), low4));
+        const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, low4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    HexEncodeScalar(src + i, n - i, dst + 2 * i, digits);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis bajtow jako cyfr szesnastkowych - wariant AVX2 (32 bajty -> 64 znaki).
+//
+CA_TARGET_AVX2
+inline void HexEncodeAvx2(const unsigned char* src, cardinal n, char* dst, const char* digits)
+{
+    const __m256i lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    cardinal i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low4));
+        const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low4));
+        // Przeplot dziala w obrebie 128-bitowych polowek - zlozenie polowek w kolejnosci bajtow
+        const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    HexEncodeScalar(src + i, n - i, dst + 2 * i, digits);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: wartosci 16 cyfr szesnastkowych (SSE2); bajty niebedace cyframi oznaczane w <invalid>.
+//
+inline __m128i HexValuesSse2(__m128i c, __m128i& invalid)
+{
+    const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i alpha = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    // Zakresy sprawdzane bez znaku: digit <= 9, alpha <= 5
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    invalid = _mm_or_si128(invalid, _mm_andnot_si128(_mm_or_si128(isDigit, isAlpha), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                        _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt cyfr szesnastkowych jako bajtow - wariant SSSE3 (32 znaki -> 16 bajtow: pary wartosci
+// laczone przez pmaddubsw jako 16 * hi + lo).
+//
+CA_TARGET_SSSE3
+inline bool HexDecodeSsse3(const char* src, cardinal n, unsigned char* dst)
+{
+    const __m128i weights = _mm_set1_epi16(0x0110);   // bajty (16, 1)
+    cardinal i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i invalid = _mm_setzero_si128();
+        const __m128i a = HexValuesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i)), invalid);
+        const __m128i b = HexValuesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i + 16)), invalid);
+        if (_mm_movemask_epi8(invalid)) return false;
+        const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), bytes);
+    }
+    return HexDecodeScalar(src + 2 * i, n - i, dst + i);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: wartosci 32 cyfr szesnastkowych (AVX2) - jak HexValuesSse2().
+//
+CA_TARGET_AVX2
+inline __m256i HexValuesAvx2(__m256i c, __m256i& invalid)
+{
+    const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    invalid = _mm256_or_si256(invalid, _mm256_andnot_si256(_mm256_or_si256(isDigit, isAlpha),
+                                                           _mm256_set1_epi8(-1)));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                           _mm256_and_si256(isAlpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt cyfr szesnastkowych jako bajtow - wariant AVX2 (64 znaki -> 32 bajty).
+//
+CA_TARGET_AVX2
+inline bool HexDecodeAvx2(const char* src, cardinal n, unsigned char* dst)
+{
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    cardinal i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i invalid = _mm256_setzero_si256();
+        const __m256i a = HexValuesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i)), invalid);
+        const __m256i b = HexValuesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i + 32)), invalid);
+        if (_mm256_movemask_epi8(invalid)) return false;
+        // Pakowanie dziala w obrebie polowek (kolejnosc 0, 2, 1, 3 slow 64-bit) - korekta permutacja
+        const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights),
+                                                   _mm256_maddubs_epi16(b, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return HexDecodeScalar(src + 2 * i, n - i, dst + i);
+}
+
+#endif // CA_SIMD_X86
+
+
+typedef void (*HexEncodeKernel)(const unsigned char* src, cardinal n, char* dst, const char* digits);
+typedef bool (*HexDecodeKernel)(const char* src, cardinal n, unsigned char* dst);
+
+//-------------------------------------------------------------------------------------------------
+// Wybor wariantow jader kodowania szesnastkowego dla biezacego procesora.
+//
+inline HexEncodeKernel SelectHexEncodeKernel(SimdLevel level)
+{
+#if defined(CA_SIMD_X86)
+    if (level >= SimdAvx2)  return &HexEncodeAvx2;
+    if (level >= SimdSsse3) return &HexEncodeSsse3;
+#endif
+    (void)level;
+    return &HexEncodeScalar;
+}
+
+inline HexDecodeKernel SelectHexDecodeKernel(SimdLevel level)
+{
+#if defined(CA_SIMD_X86)
+    if (level >= SimdAvx2)  return &HexDecodeAvx2;
+    if (level >= SimdSsse3) return &HexDecodeSsse3;
+#endif
+    (void)level;
+    return &HexDecodeScalar;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zapis <n> bajtow <src> jako 2 * n cyfr szesnastkowych do <dst> (alfabet <digits>, 16 znakow).
+//
+inline void HexEncodeBlock(const unsigned char* src, cardinal n, char* dst, const char* digits)
+{
+    static const HexEncodeKernel kernel = SelectHexEncodeKernel(ActiveSimdLevel());
+    kernel(src, n, dst, digits);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Odczyt 2 * n cyfr szesnastkowych <src> jako <n> bajtow do <dst>. Zwraca false, gdy wystapi znak
+// spoza [0-9a-fA-F] (zawartosc <dst> jest wtedy nieokreslona).
+//
+inline bool HexDecodeBlock(const char* src, cardinal n, unsigned char* dst)
+{
+    static const HexDecodeKernel kernel = SelectHexDecodeKernel(ActiveSimdLevel());
+    return kernel(src, n, dst);
+}
+
+
+} // namespace cans
+
+
+#endif // CA_STRKERNELS_H
@@ -0,0 +1,198 @@
+#ifndef CA_STRPARALLEL_H
+#define CA_STRPARALLEL_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memmove()
+//   <string>        -> std::string
+//   <vector>        -> std::vector
+//
+// Repository
+//   "numutils.h"    -> cardinal
+//   "charset.h"     -> CharSet
+//   "strkernels.h"  -> AsciiLowercaseBlock(), AsciiUppercaseBlock(), ReplaceCharBlock(),
+//                      RemoveCharsBlock()
+//   "strutils.h"    -> MakeLowercase(), MakeUppercase(), ReplaceCharInPlace(),
+//                      RemoveCharInPlace(), RemoveSetOfCharsInPlace()
+//   "workerpool.h"  -> WorkerPool
+//
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "numutils.h"
+#include "charset.h"
+#include "strkernels.h"
+#include "strutils.h"
+#include "workerpool.h"
+
+
+
+
+namespace cans
+{
+    using std::string;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Rownolegle przeksztalcenia duzych tekstow
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Wielowatkowe odpowiedniki funkcji in-place z strutils.h dla tekstow rzedu setek MB.
+//   Tekst dzielony jest na spojne fragmenty przetwarzane przez watki puli WorkerPool.
+//
+// Uwagi projektowe:
+// * Wynik jest identyczny z odpowiednia funkcja sekwencyjna.
+// * Teksty puste i krotsze niz prog <minSize> przetwarzane sa sekwencyjnie (bez kosztu
+//   synchronizacji).
+// * Operacje usuwajace znaki dzialaja w dwoch fazach: (1) rownolegle kompaktowanie kazdego
+//   fragmentu w jego wlasnym obszarze, (2) sumy prefiksowe dlugosci fragmentow wyznaczaja
+//   docelowe polozenia, pod ktore fragmenty sa dosuwane.
+//
+
+const cardinal kParallelMinSize = 1 << 20;   // domyslny prog przetwarzania rownoleglego (1 MiB)
+
+
+//-------------------------------------------------------------------------------------------------
+// Helper: podzial <n> bajtow na fragmenty - po kilka na watek puli (wyrownanie obciazenia),
+// lecz nie mniejsze niz 64 KiB. Zwraca liczbe fragmentow i ich dlugosc (ostatni moze byc krotszy);
+// pusty tekst to 0 fragmentow (dlugosc fragmentu jest zawsze >= 1).
+//
+inline cardinal SplitForPool(cardinal n, const WorkerPool& pool, cardinal& chunk)
+{
+    const cardinal kMinChunk = 1 << 16;
+    cardinal parts = pool.Size() * 4;
+    if (n / parts < kMinChunk) parts = (n + kMinChunk - 1) / kMinChunk;
+    if (parts == 0) parts = 1;
+
+    chunk = (n + parts - 1) / parts;
+    if (chunk == 0) chunk = 1;
+    return (n + chunk - 1) / chunk;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana w calym tekscie wielkich liter ASCII na male - rownolegle (jak MakeLowercase()).
+//
+inline void ParallelMakeLowercase(string& str, WorkerPool& pool, cardinal minSize = kParallelMinSize)
+{
+    // Krotkie teksty lub pula jednowatkowa - wariant sekwencyjny
+    if (str.empty() || str.size() < minSize || pool.Size() < 2) { MakeLowercase(str); return; }
+
+    char* p = &str[0];
+    const cardinal n = str.size();
+    cardinal chunk = 0;
+    const cardinal parts = SplitForPool(n, pool, chunk);
+
+    pool.Run(parts, [=](cardinal k) {
+        const cardinal b = k * chunk;
+        AsciiLowercaseBlock(p + b, (n - b < chunk) ? n - b : chunk);
+    });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana w calym tekscie malych liter ASCII na wielkie - rownolegle (jak MakeUppercase()).
+//
+inline void ParallelMakeUppercase(string& str, WorkerPool& pool, cardinal minSize = kParallelMinSize)
+{
+    if (str.empty() || str.size() < minSize || pool.Size() < 2) { MakeUppercase(str); return; }
+
+    char* p = &str[0];
+    const cardinal n = str.size();
+    cardinal chunk = 0;
+    const cardinal parts = SplitForPool(n, pool, chunk);
+
+    pool.Run(parts, [=](cardinal k) {
+        const cardinal b = k * chunk;
+        AsciiUppercaseBlock(p + b, (n - b < chunk) ? n - b : chunk);
+    });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana w calym tekscie wystapien znaku <from> na <to> - rownolegle (jak ReplaceCharInPlace()).
+//
+inline void ParallelReplaceCharInPlace(string& str, char from, char to, WorkerPool& pool,
+                                       cardinal minSize = kParallelMinSize)
+{
+    if (str.empty() || str.size() < minSize || pool.Size() < 2) { ReplaceCharInPlace(str, from, to); return; }
+    if (from == to) return;
+
+    char* p = &str[0];
+    const cardinal n = str.size();
+    cardinal chunk = 0;
+    const cardinal parts = SplitForPool(n, pool, chunk);
+
+    pool.Run(parts, [=](cardinal k) {
+        const cardinal b = k * chunk;
+        ReplaceCharBlock(p + b, (n - b < chunk) ? n - b : chunk, from, to);
+    });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z tekstu wszystkich znakow nalezacych do zbioru - rownolegle
+// (jak RemoveSetOfCharsInPlace()).
+//
+inline void ParallelRemoveSetOfCharsInPlace(string& str, const CharSet& charset, WorkerPool& pool,
+                                            cardinal minSize = kParallelMinSize)
+{
+    if (str.empty() || str.size() < minSize || pool.Size() < 2) { RemoveSetOfCharsInPlace(str, charset); return; }
+    if (charset.Empty()) return;
+
+    char* p = &str[0];
+    const cardinal n = str.size();
+    cardinal chunk = 0;
+    const cardinal parts = SplitForPool(n, pool, chunk);
+    std::vector<cardinal> kept(parts);
+
+    // Faza 1: kompaktowanie kazdego fragmentu w jego wlasnym obszarze (fragmenty sa rozlaczne)
+    cardinal* keptp = &kept[0];
+    pool.Run(parts, [=, &charset](cardinal k) {
+        const cardinal b = k * chunk;
+        keptp[k] = RemoveCharsBlock(p + b, (n - b < chunk) ? n - b : chunk, charset);
+    });
+
+    // Faza 2: suma prefiksowa dlugosci wyznacza polozenie docelowe kazdego fragmentu; fragmenty
+    // przesuwane sa kolejno, bo cel fragmentu k moze zachodzic na zrodlo fragmentow wczesniejszych
+    cardinal j = kept[0];
+    for (cardinal k = 1; k < parts; k++) {
+        memmove(p + j, p + k * chunk, kept[k]);
+        j += kept[k];
+    }
+    str.resize(j);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z tekstu wszystkich znakow podanych w lancuchu <charset> - rownolegle
+// (jak RemoveSetOfCharsInPlace() dla C-stringu).
+//
+inline void ParallelRemoveSetOfCharsInPlace(string& str, const char* charset, WorkerPool& pool,
+                                            cardinal minSize = kParallelMinSize)
+{
+    if (!charset || !*charset) return;
+    ParallelRemoveSetOfCharsInPlace(str, CharSet(charset), pool, minSize);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z tekstu wszystkich wystapien danego znaku - rownolegle (jak RemoveCharInPlace()).
+//
+inline void ParallelRemoveCharInPlace(string& str, char ch, WorkerPool& pool,
+                                      cardinal minSize = kParallelMinSize)
+{
+    if (str.empty() || str.size() < minSize || pool.Size() < 2) { RemoveCharInPlace(str, ch); return; }
+    ParallelRemoveSetOfCharsInPlace(str, CharSet(&ch, 1), pool, minSize);
+}
+
+
+} // namespace cans
+
+
+#endif // CA_STRPARALLEL_H
@@ -0,0 +1,203 @@
+#ifndef CA_STRTOKENIZER_H
+#define CA_STRTOKENIZER_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <stdint.h>      -> uint64_t
+//   <vector>        -> std::vector
+//
+// Repository
+//   "numutils.h"    -> cardinal
+//   "charset.h"     -> CharSet, CharSetOf()
+//   "strkernels.h"  -> CharSetMaskBlock(), LowestBitIndex()
+//   "strutils.h"    -> TrimView()
+//   "strview.h"     -> StrView
+//
+
+#include <stdint.h>
+#include <vector>
+
+#include "numutils.h"
+#include "charset.h"
+#include "strkernels.h"
+#include "strutils.h"
+#include "strview.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Podzial tekstu na pola
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Dzielenie tekstu na pola rozdzielone znakami ze zbioru separatorow (np. ',' / ';' / biale
+//   znaki) bez kopiowania - pola sa widokami StrView na bufor wejsciowy. Stanowi wejscie dla
+//   konwerterow StrToInt() / StrToDbl() przy przetwarzaniu duzych plikow.
+//
+// Zakres odpowiedzialnosci:
+// - Separatory wyszukiwane sa blokami po 64 bajty: jadro wektorowe wyznacza maske bitowa
+//   separatorow bloku, a granice pol odczytywane sa z kolejnych ustawionych bitow maski.
+// - Opcjonalnie pola sa przycinane z bialych znakow (TrimView) lub puste pola sa pomijane.
+//
+// Uwagi projektowe:
+// * Tekst z k separatorami daje k + 1 pol (np. "a,,b" -> "a", "", "b"); pusty tekst - zadnego.
+// * Widoki pol wskazuja na bufor wejsciowy - musi on istniec dluzej niz wynik podzialu.
+// * Wynik Split() trafia do wektora wywolujacego, ktorego pojemnosc jest uzywana ponownie
+//   (brak alokacji w ustalonym stanie przetwarzania).
+//
+
+class FieldSplitter
+{
+public:
+    //---------------------------------------------------------------------------------------------
+    // Opcje podzialu (flagi bitowe)
+    //
+    enum Options
+    {
+        KeepAll    = 0,    // pola zwracane bez zmian, lacznie z pustymi
+        TrimFields = 1,    // przyciecie bialych znakow z obu stron kazdego pola
+        SkipEmpty  = 2     // pominiecie pol pustych (po ewentualnym przycieciu)
+    };
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie podzialu wg zbioru separatorow <delimiters> i opcji <options>.
+    //
+    explicit FieldSplitter(const CharSet& delimiters, unsigned options = KeepAll)
+        : delimiters_(delimiters), options_(options)
+    {
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie podzialu wg separatorow podanych w lancuchu <delimiters> (C-string).
+    //
+    explicit FieldSplitter(const char* delimiters, unsigned options = KeepAll)
+        : delimiters_(delimiters), options_(options)
+    {
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Podzial wg przecinkow (CSV) / srednikow / ciagow bialych znakow.
+    //
+    static FieldSplitter Comma(unsigned options = KeepAll)
+    {
+        return FieldSplitter(CharSetOf<','>(), options);
+    }
+
+    static FieldSplitter Semicolon(unsigned options = KeepAll)
+    {
+        return FieldSplitter(CharSetOf<';'>(), options);
+    }
+
+    static FieldSplitter Whitespace()
+    {
+        return FieldSplitter(CharSetOf<' ', '\t', '\n', '\v', '\f', '\r'>(), SkipEmpty);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Wywolanie <callback>(StrView pole) dla kolejnych pol tekstu <text>.
+    // Zwraca liczbe przekazanych pol.
+    //
+    template <class Callback>
+    cardinal ForEachField(StrView text, Callback callback) const
+    {
+        if (text.empty()) return 0;
+
+        const char* p = text.data();
+        const cardinal n = text.size();
+        cardinal start = 0, count = 0;
+
+        // Iteracja po blokach 64-bajtowych tekstu ...
+        for (cardinal base = 0; base < n; base += 64)
+        {
+            const cardinal len = (n - base < 64) ? n - base : 64;
+            uint64_t mask = CharSetMaskBlock(p + base, len, delimiters_);
+            // ... i po separatorach bloku (kolejne ustawione bity maski)
+            while (mask) {
+                const cardinal pos = base + LowestBitIndex(mask);
+                mask &= mask - 1;
+                count += Deliver(StrView(p + start, pos - start), callback);
+                start = pos + 1;
+            }
+        }
+        // Pole za ostatnim separatorem
+        count += Deliver(StrView(p + start, n - start), callback);
+        return count;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Podzial tekstu <text> z zapisem pol do <fields> (poprzednia zawartosc jest zastepowana,
+    // a pojemnosc wektora uzywana ponownie). Zwraca liczbe pol.
+    //
+    cardinal Split(StrView text, std::vector<StrView>& fields) const
+    {
+        fields.clear();
+        return ForEachField(text, FieldAppender(fields));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Podzial tekstu <text> (zwraca nowy wektor pol).
+    //
+    std::vector<StrView> Split(StrView text) const
+    {
+        std::vector<StrView> fields;
+        Split(text, fields);
+        return fields;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Zbior separatorow i opcje podzialu.
+    //
+    const CharSet& Delimiters() const { return delimiters_; }
+    unsigned OptionFlags() const { return options_; }
+
+private:
+    //---------------------------------------------------------------------------------------------
+    // Helper: dopisanie pola do wektora (odpowiednik lambdy dla C++11 bez auto w parametrach)
+    //
+    struct FieldAppender
+    {
+        explicit FieldAppender(std::vector<StrView>& fields) : fields_(&fields) {}
+        void operator()(StrView field) const { fields_->push_back(field); }
+        std::vector<StrView>* fields_;
+    };
+
+    //---------------------------------------------------------------------------------------------
+    // Przekazanie pola (po zastosowaniu opcji) do <callback>. Zwraca 1, gdy pole przekazano.
+    //
+    template <class Callback>
+    cardinal Deliver(StrView field, Callback& callback) const
+    {
+        if (options_ & TrimFields) field = TrimView(field);
+        if ((options_ & SkipEmpty) && field.empty()) return 0;
+
+        callback(field);
+        return 1;
+    }
+
+    CharSet delimiters_;   // zbior separatorow pol
+    unsigned options_;     // opcje podzialu (Options)
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Podzial tekstu <text> wg separatorow <delimiters> z zapisem pol do <fields>.
+// Zwraca liczbe pol.
+//
+inline cardinal SplitFields(StrView text, const CharSet& delimiters, std::vector<StrView>& fields,
+                            unsigned options = FieldSplitter::KeepAll)
+{
+    return FieldSplitter(delimiters, options).Split(text, fields);
+}
+
+
+} // namespace cans
+
+
+#endif // CA_STRTOKENIZER_H
@@ -5,17 +5,26 @@
 // Zaleznosci (naglowki uzyte w tym module):
 //
 // C++ / STL
-//   <cctype>     -> isspace()
+//   <cstring>    -> memchr(), memmove()
 //   <string>     -> std::string
+//   <utility>    -> std::move()
 //
 // Repository
-//   "numutils.h" -> cardinal
+//   "numutils.h"   -> cardinal, CA_CONSTEXPR
+//   "charset.h"    -> CharSet
+//   "strview.h"    -> StrView, ViewToStr()
+//   "strkernels.h" -> AsciiLowercaseBlock(), AsciiUppercaseBlock(), ReplaceCharBlock(),
+//                     RemoveCharsBlock(), RemoveCharsCopyBlock()
 //
 
-#include <cctype>
+#include <cstring>
 #include <string>
+#include <utility>
 
 #include "numutils.h"
+#include "charset.h"
+#include "strkernels.h"
+#include "strview.h"
 
 
 
@@ -39,27 +48,31 @@ namespace cans
 // - Operacje na pojedynczych znakach ASCII (klasyfikacja: cyfra, litera, bialy znak, itp.)
 // - Proste modyfikacje tekstu in-place (zmiana wielkosci liter, podmiana znakow)
 // - Proste transformacje jak wyzej, lecz zwracajace nowy tekst
+// - Przycinanie i przeszukiwanie widokow StrView (bez kopiowania i alokacji)
 // - Funkcje nie wykonuja walidacji semantycznej, parsowania ani interpretacji.
 //
 // Uwagi projektowe:
 // * Modul obsluguje wylacznie 8-bitowe znaki (ASCII) i nie nadaje sie do tekstow Unicode.
 // * Funkcje operujace na C-stringach nie moga przetwarzac znakow o wartosci 0 ('\0')
+//   (ograniczenie to nie dotyczy zbiorow znakow CharSet)
+// * Przeciazenia dla tekstu tymczasowego (string&&) przeksztalcaja bufor argumentu i przenosza
+//   go do wyniku - bez kopiowania i bez alokacji.
 //
 
 //-------------------------------------------------------------------------------------------------
-// Sprawdzenie, czy bialy znak.
+// Sprawdzenie, czy bialy znak (niezaleznie od ustawien lokalnych).
 //
-inline bool IsAsciiWhitespace(char ch)
+CA_CONSTEXPR bool IsAsciiWhitespace(char ch)
 {
-    // Zwrocenie true dla bialych znakow: '\t', '\n', '\v', '\f', '\r', ' '
-    return ::isspace(static_cast<unsigned char>(ch));
+    // Zwrocenie true dla bialych znakow: '\t', '\n', '\v', '\f', '\r' (zakres 0x09..0x0D), ' '
+    return (ch == ' ') || ('\t' <= ch && ch <= '\r');
 }
 
 
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy cyfra ASCII.
 //
-inline bool IsAsciiDigit(char ch)
+CA_CONSTEXPR bool IsAsciiDigit(char ch)
 {
     // Zwrocenie true dla znakow z zakresu [0-9]
     return ('0' <= ch && ch <= '9');
@@ -69,7 +82,7 @@ inline bool IsAsciiDigit(char ch)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy kropka ASCII.
 //
-inline bool IsAsciiDot(char ch)
+CA_CONSTEXPR bool IsAsciiDot(char ch)
 {
     // Zwrocenie true dla znaku [.]
     return (ch == '.');
@@ -79,7 +92,7 @@ inline bool IsAsciiDot(char ch)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy przecinek ASCII.
 //
-inline bool IsAsciiColon(char ch)
+CA_CONSTEXPR bool IsAsciiColon(char ch)
 {
     // Zwrocenie true dla znaku [,]
     return (ch == ',');
@@ -89,7 +102,7 @@ inline bool IsAsciiColon(char ch)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy srednik ASCII.
 //
-inline bool IsAsciiSemicolon(char ch)
+CA_CONSTEXPR bool IsAsciiSemicolon(char ch)
 {
     // Zwrocenie true dla znaku [;]
     return (ch == ';');
@@ -99,7 +112,7 @@ inline bool IsAsciiSemicolon(char ch)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy wielka litera ASCII.
 //
-inline bool IsAsciiUpperAlpha(char ch)
+CA_CONSTEXPR bool IsAsciiUpperAlpha(char ch)
 {
     // Zwrocenie true dla znakow z zakresu [A-Z]
     return ('A' <= ch && ch <= 'Z');
@@ -109,7 +122,7 @@ inline bool IsAsciiUpperAlpha(char ch)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy mala litera ASCII.
 //
-inline bool IsAsciiLowerAlpha(char ch)
+CA_CONSTEXPR bool IsAsciiLowerAlpha(char ch)
 {
     // Zwrocenie true dla znakow z zakresu [a-z]
     return ('a' <= ch && ch <= 'z');
@@ -119,7 +132,7 @@ inline bool IsAsciiLowerAlpha(char ch)
 //-------------------------------------------------------------------------------------------------
 // Sprawdzenie, czy litera ASCII.
 //
-inline bool IsAsciiAlpha(char ch)
+CA_CONSTEXPR bool IsAsciiAlpha(char ch)
 {
     // Zwrocenie true dla znakow z zakresu [A-Za-z]
     return ('A' <= ch && ch <= 'Z') || ('a' <= ch && ch <= 'z');
@@ -128,16 +141,16 @@ inline bool IsAsciiAlpha(char ch)
 
 //-------------------------------------------------------------------------------------------------
 // Zamiana w calym tekscie wielkich liter ASCII na male (modyfikacja in-place).
+// Tekst przetwarzany jest blokowo (SWAR/SSE2/AVX2 wg mozliwosci procesora), z wynikiem
+// identycznym jak dla referencyjnej petli po znakach - FlipCaseScalar() w strkernels.h.
 //
 inline void MakeLowercase(string& str)
 {
-    // Iteracja po znakach tekstu ...
-    for (cardinal i = 0; i < str.size(); i++) {
-        // ... z podmiana liter [A-Z] na [a-z]  (constant folding 'a' - 'A' = 32)
-        char& ch = str[i];
-        if (IsAsciiUpperAlpha(ch)) 
-            ch += char('a' - 'A');
-    }
+    // Jezeli tekst jest pusty, zakonczenie bez zmian
+    if (str.empty()) return;
+
+    // Podmiana liter [A-Z] na [a-z] w calym buforze tekstu
+    AsciiLowercaseBlock(&str[0], str.size());
     // Wynik oddany przez referencje
 }
 
@@ -157,10 +170,20 @@ inline string ToLowercase(const string& str)
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Zamiana w calym tekscie wielkich liter ASCII na male (tekst tymczasowy).
+//
+inline string ToLowercase(string&& str)
+{
+    MakeLowercase(str);
+    return std::move(str);
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Zamiana malej litery ASCII na wielka (zwraca nowy znak).
 //
-inline char ToLowerAlpha(const char ch)
+CA_CONSTEXPR char ToLowerAlpha(const char ch)
 {
     // Zwrocenie malej litery
     return IsAsciiUpperAlpha(ch) ? char(ch + ('a' - 'A')) : ch;
@@ -169,16 +192,15 @@ inline char ToLowerAlpha(const char ch)
 
 //-------------------------------------------------------------------------------------------------
 // Zamiana w calym tekscie malych liter ASCII na wielkie (modyfikacja in-place).
+// Przetwarzanie blokowe, analogicznie jak w MakeLowercase().
 //
 inline void MakeUppercase(string& str)
 {
-    // Iteracja po znakach tekstu ...
-    for (cardinal i = 0; i < str.size(); i++) {
-        // ... z podmiana liter [a-z] na [A-Z]  (constant folding 'a' - 'A' = 32)
-        char& ch = str[i];
-        if (IsAsciiLowerAlpha(ch)) 
-            ch -= char('a' - 'A');
-    }
+    // Jezeli tekst jest pusty, zakonczenie bez zmian
+    if (str.empty()) return;
+
+    // Podmiana liter [a-z] na [A-Z] w calym buforze tekstu
+    AsciiUppercaseBlock(&str[0], str.size());
     // Wynik oddany przez referencje
 }
 
@@ -198,10 +220,20 @@ inline string ToUppercase(const string& str)
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Zamiana w calym tekscie malych liter ASCII na wielkie (tekst tymczasowy).
+//
+inline string ToUppercase(string&& str)
+{
+    MakeUppercase(str);
+    return std::move(str);
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Zamiana malej litery ASCII na wielka (zwraca nowy znak).
 //
-inline char ToUpperAlpha(const char ch)
+CA_CONSTEXPR char ToUpperAlpha(const char ch)
 {
     // Zwrocenie wielkiej litery
     return IsAsciiLowerAlpha(ch) ? char(ch - ('a' - 'A')) : ch;
@@ -261,20 +293,26 @@ inline string ToLetterCase(const string& str, LetterCase style)
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Zastosowanie wybranego stylu literowego do tekstu (tekst tymczasowy).
+//
+inline string ToLetterCase(string&& str, LetterCase style)
+{
+    ApplyLetterCase(str, style);
+    return std::move(str);
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Zamiana w calym tekscie wystapien znaku <from> na <to> (modyfikacja in-place).
 //
 inline void ReplaceCharInPlace(string& str, char from, char to)
 {
     // Jezeli nie ma co zmieniac, zakonczenie
-    if (from == to) return;
+    if (from == to || str.empty()) return;
 
-    // Iteracja po znakach tekstu ...
-    for (cardinal i = 0; i < str.size(); i++) {
-        // ... z podmiana wszystkich wystapien znaku 'from' na 'to
-        if (str[i] == from)
-            str[i] = to;
-    }
+    // Podmiana wszystkich wystapien znaku 'from' na 'to' w calym buforze tekstu
+    ReplaceCharBlock(&str[0], str.size(), from, to);
     // Wynik oddany przez referencje
 }
 
@@ -294,6 +332,16 @@ inline string ReplaceChar(const string& str, char from, char to)
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Zamiana w calym tekscie wystapien znaku <from> na <to> (tekst tymczasowy).
+//
+inline string ReplaceChar(string&& str, char from, char to)
+{
+    ReplaceCharInPlace(str, from, to);
+    return std::move(str);
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Usuniecie z tekstu wszystkich wystapien danego znaku (modyfikacja in-place).
 //
@@ -327,39 +375,154 @@ inline string RemoveChar(const string& str, char ch)
 
 
 //-------------------------------------------------------------------------------------------------
-// Usuniecie bialych znakow z obu stron tekstu (zwraca nowy tekst).
+// Usuniecie z tekstu wszystkich wystapien danego znaku (tekst tymczasowy).
 //
-inline string TrimStr(const string& str)
+inline string RemoveChar(string&& str, char ch)
 {
-    // Ustalenie liczby znakow w tekscie
-    const cardinal n = str.size();
+    RemoveCharInPlace(str, ch);
+    return std::move(str);
+}
 
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie bialych znakow z poczatku widoku tekstu (zwraca zawezony widok, bez kopiowania).
+//
+inline StrView TrimLeftView(StrView view)
+{
     cardinal b = 0;
-    // Wyszukanie pierwszego znaku innego niz znak bialy, ...
-    while (b < n && IsAsciiWhitespace(str[b])) b++;
-    // ... a jesli brak, to zwrocenie pustego lancucha i zakonczenie
-    if (b == n) return string();
+    // Wyszukanie pierwszego znaku innego niz znak bialy
+    while (b < view.size() && IsAsciiWhitespace(view[b])) b++;
+
+    // Zwrocenie widoku bez poczatkowych bialych znakow
+    view.remove_prefix(b);
+    return view;
+}
+
 
-    cardinal e = n;
+//-------------------------------------------------------------------------------------------------
+// Usuniecie bialych znakow z konca widoku tekstu (zwraca zawezony widok, bez kopiowania).
+//
+inline StrView TrimRightView(StrView view)
+{
+    cardinal e = view.size();
     // Wyszukanie pierwszego od konca znaku innego niz znak bialy
-    while (e > b && IsAsciiWhitespace(str[e -1])) e--;
+    while (e > 0 && IsAsciiWhitespace(view[e -1])) e--;
+
+    // Zwrocenie widoku bez koncowych bialych znakow
+    view.remove_suffix(view.size() - e);
+    return view;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie bialych znakow z obu stron widoku tekstu (zwraca zawezony widok, bez kopiowania).
+//
+inline StrView TrimView(StrView view)
+{
+    // Najpierw przyciecie poczatku (gdy caly widok jest bialy, zostaje pusty), potem konca
+    return TrimRightView(TrimLeftView(view));
+}
+
 
-    // Jezeli znaleziono jakiekolwiek biale znaki ...
-    if (e - b < n)
-        // ... zwrocenie tekstu obustronnie oczyszczonego
-        return str.substr(b, e - b);
-    // ... w przeciwnym razie, wynik bez zmian
-    return str;
+//-------------------------------------------------------------------------------------------------
+// Usuniecie bialych znakow z obu stron tekstu (zwraca nowy tekst).
+//
+inline string TrimStr(const string& str)
+{
+    // Wyznaczenie obustronnie oczyszczonego fragmentu tekstu (bez kopiowania)
+    const StrView view = TrimView(str);
+
+    // Jezeli nie znaleziono zadnych bialych znakow, wynik bez zmian ...
+    if (view.size() == str.size())
+        return str;
+    // ... w przeciwnym razie zwrocenie kopii oczyszczonego fragmentu
+    return ViewToStr(view);
 }
 
 
 //-------------------------------------------------------------------------------------------------
 // Usuniecie bialych znakow z obu stron tekstu (modyfikacja in-place).
+// Przyciecie odbywa sie w istniejacym buforze tekstu, bez ponownej alokacji.
 //
 inline void TrimStrInPlace(string& str)
 {
-    // Przyciecie tekstu i oddanie wyniku przez referencje
-    str = TrimStr(str);
+    // Wyznaczenie oczyszczonego fragmentu tekstu, ...
+    const StrView view = TrimView(str);
+    const cardinal b = static_cast<cardinal>(view.data() - str.data());
+
+    // ... odciecie koncowki za fragmentem i poczatku przed nim
+    str.erase(b + view.size());
+    str.erase(0, b);
+    // Wynik oddany przez referencje
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie bialych znakow z obu stron tekstu (tekst tymczasowy).
+//
+inline string TrimStr(string&& str)
+{
+    TrimStrInPlace(str);
+    return std::move(str);
+}
+
+
+const cardinal kNotFound = cardinal(-1);   // wynik wyszukiwania: brak trafienia
+
+
+//-------------------------------------------------------------------------------------------------
+// Wyszukanie pierwszego wystapienia znaku w widoku tekstu.
+// Zwraca pozycje znaku lub kNotFound.
+//
+inline cardinal FindChar(StrView view, char ch)
+{
+    // Jezeli widok jest pusty, brak trafienia
+    if (view.empty()) return kNotFound;
+
+    // Wyszukanie znaku w buforze (memchr - implementacja biblioteczna, zwykle wektorowa)
+    const void* p = memchr(view.data(), static_cast<unsigned char>(ch), view.size());
+    return p ? static_cast<cardinal>(static_cast<const char*>(p) - view.data()) : kNotFound;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Wyszukanie pierwszego znaku widoku tekstu nalezacego do zbioru <charset>.
+// Zwraca pozycje znaku lub kNotFound.
+//
+inline cardinal FindFirstOf(StrView view, const CharSet& charset)
+{
+    // Iteracja po znakach widoku az do pierwszego znaku ze zbioru
+    for (cardinal i = 0; i < view.size(); i++) {
+        if (charset.Contains(view[i])) return i;
+    }
+    return kNotFound;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Wyszukanie pierwszego znaku widoku tekstu nienalezacego do zbioru <charset>.
+// Zwraca pozycje znaku lub kNotFound.
+//
+inline cardinal FindFirstNotOf(StrView view, const CharSet& charset)
+{
+    // Iteracja po znakach widoku az do pierwszego znaku spoza zbioru
+    for (cardinal i = 0; i < view.size(); i++) {
+        if (!charset.Contains(view[i])) return i;
+    }
+    return kNotFound;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zliczenie wystapien znaku w widoku tekstu.
+//
+inline cardinal CountChar(StrView view, char ch)
+{
+    cardinal n = 0;
+    // Iteracja po znakach widoku (petla bezskokowa, podatna na wektoryzacje przez kompilator)
+    for (cardinal i = 0; i < view.size(); i++)
+        n += (view[i] == ch);
+    return n;
 }
 
 
@@ -367,17 +530,53 @@ inline void TrimStrInPlace(string& str)
 // Sprawdzenie, czy znak znajduje sie w podanym lancuchu <cstr>.
 // Poszukiwany znak nie moze byc '\0' (ograniczenie wynika z natury C-String).
 //
-inline bool IsCharInCString(char ch, const char* cstr)
+CA_CONSTEXPR bool IsCharInCString(char ch, const char* cstr)
 {
-    // Iteracja po znakach lancucha (C-string zakonczony '\0') ...
-    for (const char* c = cstr; *c; c++) {
-        // ... i porownywanie, czy biezacy znak jest tym szukanym, ...
-        if (*c == ch)
-            // ... bo jesli tak, to zakonczenie z potwierdzeniem
-            return true;
-    }
-    // Jezeli petla dobiegla konca, znak nie wystapil w lancuchu - zakonczenie negatywne
-    return false;
+    // Lancuch niepusty, a jego pierwszy znak jest tym szukanym lub szukany wystepuje w reszcie
+    // lancucha (postac constexpr C++11 - rekurencja ogonowa zamiast petli)
+    return *cstr != '\0' && (*cstr == ch || IsCharInCString(ch, cstr + 1));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z tekstu wszystkich wystapien znakow nalezacych do zbioru <charset>
+// (modyfikacja in-place).
+//
+inline void RemoveSetOfCharsInPlace(string& str, const CharSet& charset)
+{
+    // Jezeli zbior znakow do usuniecia jest pusty lub tekst jest pusty, zakonczenie bez zmian
+    if (charset.Empty() || str.empty()) return;
+
+    // Kompaktowanie w miejscu (pozostawione znaki dosuwane do poczatku) - przetwarzanie blokowe
+    const cardinal j = RemoveCharsBlock(&str[0], str.size(), charset);
+    // Ustawienie nowej dlugosci tekstu (odciecie usunietej koncowki) i oddanie go przez referencje
+    str.resize(j);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z tekstu wszystkich wystapien znakow nalezacych do zbioru <charset>
+// (zwraca nowy tekst).
+//
+inline string RemoveSetOfChars(const string& str, const CharSet& charset)
+{
+    // Skopiowanie tekstu do bufora wynikowego ...
+    string bufstr = str;
+    // ... i modyfikacja in-place
+    RemoveSetOfCharsInPlace(bufstr, charset);
+
+    // Zwrocenie tekstu wynikowego
+    return bufstr;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z tekstu wszystkich wystapien znakow nalezacych do zbioru <charset> (tekst tymczasowy).
+//
+inline string RemoveSetOfChars(string&& str, const CharSet& charset)
+{
+    RemoveSetOfCharsInPlace(str, charset);
+    return std::move(str);
 }
 
 
@@ -385,24 +584,15 @@ inline bool IsCharInCString(char ch, const char* cstr)
 // Usuniecie z tekstu wszystkich wystapien znakow podanych w lancuchu <charset>, tj. w zbiorze
 // znakow do usuniecia (modyfikacja in-place).
 // Usuwanym znakiem nie moze byc '\0' (ograniczenie wynika z natury C-String).
+// Przy wielokrotnym uzyciu tego samego zbioru korzystniej jest zbudowac CharSet raz.
 //
 inline void RemoveSetOfCharsInPlace(string& str, const char* charset)
 {
     // Jezeli nie podano zbioru znakow do usuniecia lub jest on pusty, zakonczenie bez zmian
     if (!charset || !*charset) return;
 
-    cardinal j = 0;
-    // Iteracja po znakach tekstu, ...
-    for (cardinal i = 0; i < str.size(); ++i) {
-        // ... ze sprawdzaniem czy wystepuja w zbiorze znakow do usuniecia ...
-        if (IsCharInCString(str[i], charset))
-            // ... bo jesli tak, to pominiecie ich przepisywania
-            continue;
-        // ... reszta jest progresywnie przepisywana (tzw. "kompaktowanie w miejscu")
-        str[j++] = str[i];
-    }
-    // Ustawienie nowej dlugosci tekstu (odciecie usunietej koncowki) i oddanie go przez referencje
-    str.resize(j);
+    // Zbudowanie mapy bitowej zbioru i usuniecie jego znakow z tekstu
+    RemoveSetOfCharsInPlace(str, CharSet(charset));
 }
 
 
@@ -423,6 +613,217 @@ inline string RemoveSetOfChars(const string& str, const char* charset)
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Usuniecie z tekstu wszystkich wystapien znakow podanych w lancuchu <charset> (tekst tymczasowy).
+//
+inline string RemoveSetOfChars(string&& str, const char* charset)
+{
+    RemoveSetOfCharsInPlace(str, charset);
+    return std::move(str);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Warianty z wynikiem zapisywanym do bufora lub iteratora wywolujacego
+//-------------------------------------------------------------------------------------------------
+// Odpowiedniki funkcji "zwraca nowy tekst", ktore nie tworza obiektu string:
+// - XxxCopy(in, ..., out, capacity, written) - zapis do bufora <out> o pojemnosci <capacity>.
+//   Zwraca false, gdy wynik nie miesci sie w buforze (<written> pozostaje wtedy bez zmian,
+//   a zawartosc bufora jest nieokreslona). Bufor moze zaczynac sie w miejscu tekstu <in>
+//   (przeksztalcenie w miejscu), ale nie moze zachodzic na niego inaczej.
+// - XxxCopy(in, ..., out) - zapis przez iterator wyjsciowy; zwraca iterator za ostatnim znakiem.
+//
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana wielkich liter ASCII na male z zapisem do bufora wywolujacego.
+//
+inline bool ToLowercaseCopy(StrView in, char* out, cardinal capacity, cardinal& written)
+{
+    if (in.size() > capacity) return false;
+
+    if (!in.empty()) {
+        memmove(out, in.data(), in.size());
+        AsciiLowercaseBlock(out, in.size());
+    }
+    written = in.size();
+    return true;
+}
+
+template <class OutputIt>
+inline OutputIt ToLowercaseCopy(StrView in, OutputIt out)
+{
+    for (cardinal i = 0; i < in.size(); i++)
+        *out++ = ToLowerAlpha(in[i]);
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana malych liter ASCII na wielkie z zapisem do bufora wywolujacego.
+//
+inline bool ToUppercaseCopy(StrView in, char* out, cardinal capacity, cardinal& written)
+{
+    if (in.size() > capacity) return false;
+
+    if (!in.empty()) {
+        memmove(out, in.data(), in.size());
+        AsciiUppercaseBlock(out, in.size());
+    }
+    written = in.size();
+    return true;
+}
+
+template <class OutputIt>
+inline OutputIt ToUppercaseCopy(StrView in, OutputIt out)
+{
+    for (cardinal i = 0; i < in.size(); i++)
+        *out++ = ToUpperAlpha(in[i]);
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zastosowanie wybranego stylu literowego z zapisem do bufora wywolujacego.
+//
+inline bool ToLetterCaseCopy(StrView in, LetterCase style, char* out, cardinal capacity,
+                             cardinal& written)
+{
+    if (style == Uppercase) return ToUppercaseCopy(in, out, capacity, written);
+    if (!ToLowercaseCopy(in, out, capacity, written)) return false;
+
+    // Capitalize: podniesienie pierwszego znaku, o ile wynik nie jest pusty
+    if (style == Capitalize && written > 0)
+        out[0] = ToUpperAlpha(out[0]);
+    return true;
+}
+
+template <class OutputIt>
+inline OutputIt ToLetterCaseCopy(StrView in, LetterCase style, OutputIt out)
+{
+    for (cardinal i = 0; i < in.size(); i++) {
+        const bool upper = (style == Uppercase) || (style == Capitalize && i == 0);
+        *out++ = upper ? ToUpperAlpha(in[i]) : ToLowerAlpha(in[i]);
+    }
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zamiana wystapien znaku <from> na <to> z zapisem do bufora wywolujacego.
+//
+inline bool ReplaceCharCopy(StrView in, char from, char to, char* out, cardinal capacity,
+                            cardinal& written)
+{
+    if (in.size() > capacity) return false;
+
+    if (!in.empty()) {
+        memmove(out, in.data(), in.size());
+        if (from != to) ReplaceCharBlock(out, in.size(), from, to);
+    }
+    written = in.size();
+    return true;
+}
+
+template <class OutputIt>
+inline OutputIt ReplaceCharCopy(StrView in, char from, char to, OutputIt out)
+{
+    for (cardinal i = 0; i < in.size(); i++)
+        *out++ = (in[i] == from) ? to : in[i];
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie znakow nalezacych do zbioru <charset> z zapisem do bufora wywolujacego.
+//
+inline bool RemoveSetOfCharsCopy(StrView in, const CharSet& charset, char* out, cardinal capacity,
+                                 cardinal& written)
+{
+    // Bufor mieszczacy cale wejscie - kompaktowanie blokowe (jadra zapisuja pelnymi rejestrami)
+    if (capacity >= in.size()) {
+        written = in.empty() ? 0 : RemoveCharsCopyBlock(in.data(), in.size(), out, charset);
+        return true;
+    }
+
+    // Bufor mniejszy niz wejscie - przepisywanie z kontrola pojemnosci
+    cardinal j = 0;
+    for (cardinal i = 0; i < in.size(); i++) {
+        if (charset.Contains(in[i])) continue;
+        if (j == capacity) return false;
+        out[j++] = in[i];
+    }
+    written = j;
+    return true;
+}
+
+template <class OutputIt>
+inline OutputIt RemoveSetOfCharsCopy(StrView in, const CharSet& charset, OutputIt out)
+{
+    for (cardinal i = 0; i < in.size(); i++) {
+        if (!charset.Contains(in[i])) *out++ = in[i];
+    }
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie znakow podanych w lancuchu <charset> z zapisem do bufora wywolujacego.
+// Usuwanym znakiem nie moze byc '\0'; brak zbioru (NULL) lub zbior pusty - kopia bez zmian.
+//
+inline bool RemoveSetOfCharsCopy(StrView in, const char* charset, char* out, cardinal capacity,
+                                 cardinal& written)
+{
+    return RemoveSetOfCharsCopy(in, CharSet(charset), out, capacity, written);
+}
+
+template <class OutputIt>
+inline OutputIt RemoveSetOfCharsCopy(StrView in, const char* charset, OutputIt out)
+{
+    return RemoveSetOfCharsCopy(in, CharSet(charset), out);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie wszystkich wystapien danego znaku z zapisem do bufora wywolujacego.
+//
+inline bool RemoveCharCopy(StrView in, char ch, char* out, cardinal capacity, cardinal& written)
+{
+    return RemoveSetOfCharsCopy(in, CharSet(&ch, 1), out, capacity, written);
+}
+
+template <class OutputIt>
+inline OutputIt RemoveCharCopy(StrView in, char ch, OutputIt out)
+{
+    for (cardinal i = 0; i < in.size(); i++) {
+        if (in[i] != ch) *out++ = in[i];
+    }
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Usuniecie bialych znakow z obu stron tekstu z zapisem do bufora wywolujacego.
+//
+inline bool TrimStrCopy(StrView in, char* out, cardinal capacity, cardinal& written)
+{
+    const StrView view = TrimView(in);
+    if (view.size() > capacity) return false;
+
+    if (!view.empty()) memmove(out, view.data(), view.size());
+    written = view.size();
+    return true;
+}
+
+template <class OutputIt>
+inline OutputIt TrimStrCopy(StrView in, OutputIt out)
+{
+    const StrView view = TrimView(in);
+    for (cardinal i = 0; i < view.size(); i++)
+        *out++ = view[i];
+    return out;
+}
+
+
 } // namespace cans
 
 
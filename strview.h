@@ -0,0 +1,138 @@
+#ifndef CA_STRVIEW_H
+#define CA_STRVIEW_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> strlen(), memcmp()
+//   <string>        -> std::string
+//   <string_view>   -> std::string_view (tylko C++17 i nowsze)
+//
+// Repository
+//   "numutils.h"    -> cardinal
+//
+
+#include <cstring>
+#include <string>
+
+#include "numutils.h"
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define CA_HAS_STD_STRING_VIEW 1
+#include <string_view>
+#endif
+
+
+
+
+namespace cans
+{
+    using std::string;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Widok tekstu (bez wlasnosci danych)
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Lekka para (wskaznik, dlugosc) wskazujaca fragment cudzego bufora tekstowego. Pozwala
+//   analizowac i przycinac pola duzych buforow bez kopiowania i bez alokacji pamieci.
+//
+// Uwagi projektowe:
+// * W C++17 i nowszych StrView jest aliasem std::string_view. W C++11/14 jest to minimalna klasa
+//   o tym samym interfejsie (podzbiorze uzywanym w repozytorium).
+// * Widok nie przedluza zycia danych - bufor zrodlowy musi istniec dluzej niz widok.
+// * Dane widoku nie musza byc zakonczone '\0'.
+//
+
+#if defined(CA_HAS_STD_STRING_VIEW)
+
+typedef std::string_view StrView;
+
+#else
+
+class StrView
+{
+public:
+    typedef const char* const_iterator;
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie pustego widoku.
+    //
+    StrView() : data_(NULL), size_(0) {}
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie widoku na <n> znakow bufora <p>.
+    //
+    StrView(const char* p, cardinal n) : data_(p), size_(n) {}
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie widoku na lancuch C-string (bez terminatora).
+    //
+    StrView(const char* cstr) : data_(cstr), size_(strlen(cstr)) {}
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie widoku na tresc tekstu std::string.
+    //
+    StrView(const string& str) : data_(str.data()), size_(str.size()) {}
+
+    const char* data() const { return data_; }
+    cardinal size() const { return size_; }
+    cardinal length() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    char operator[](cardinal i) const { return data_[i]; }
+    char front() const { return data_[0]; }
+    char back() const { return data_[size_ -1]; }
+
+    //---------------------------------------------------------------------------------------------
+    // Odciecie <n> znakow z poczatku / konca widoku (n nie moze przekraczac dlugosci).
+    //
+    void remove_prefix(cardinal n) { data_ += n; size_ -= n; }
+    void remove_suffix(cardinal n) { size_ -= n; }
+
+    //---------------------------------------------------------------------------------------------
+    // Podwidok od pozycji <pos> (nie wiekszej niz dlugosc), o dlugosci co najwyzej <n>.
+    //
+    StrView substr(cardinal pos, cardinal n = cardinal(-1)) const
+    {
+        const cardinal rest = size_ - pos;
+        return StrView(data_ + pos, (n < rest) ? n : rest);
+    }
+
+private:
+    const char* data_;
+    cardinal size_;
+};
+
+
+inline bool operator==(StrView a, StrView b)
+{
+    return a.size() == b.size() && (a.size() == 0 || memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+inline bool operator!=(StrView a, StrView b)
+{
+    return !(a == b);
+}
+
+#endif // CA_HAS_STD_STRING_VIEW
+
+
+//-------------------------------------------------------------------------------------------------
+// Utworzenie tekstu std::string z zawartosci widoku (kopia danych).
+//
+inline string ViewToStr(StrView view)
+{
+    return view.empty() ? string() : string(view.data(), view.size());
+}
+
+
+} // namespace cans
+
+
+#endif // CA_STRVIEW_H
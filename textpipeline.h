@@ -0,0 +1,213 @@
+#ifndef CA_TEXTPIPELINE_H
+#define CA_TEXTPIPELINE_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <string>        -> std::string
+//   <vector>        -> std::vector
+//
+// Repository
+//   "numutils.h"    -> cardinal
+//   "charset.h"     -> CharSet
+//   "chartranslator.h" -> CharTranslator
+//   "strutils.h"    -> IsAsciiWhitespace()
+//   "strview.h"     -> StrView
+//
+
+#include <string>
+#include <vector>
+
+#include "numutils.h"
+#include "charset.h"
+#include "chartranslator.h"
+#include "strutils.h"
+#include "strview.h"
+
+
+
+
+namespace cans
+{
+    using std::string;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Potok przeksztalcen tekstu
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Skladanie sekwencji elementarnych przeksztalcen z strutils.h w jeden obiekt, np.:
+//     TextPipeline().Trim().Lower().Remove(",;").Replace('_', '-')
+//   i wykonanie ich jednym przebiegiem po tekscie wejsciowym, z jednym buforem wynikowym.
+//
+// Zakres odpowiedzialnosci:
+// - Kroki znakowe (Lower, Upper, Replace, Remove) skladane sa w jedno odwzorowanie
+//   CharTranslator (tablica 256 odwzorowan bajtow wraz ze zbiorem bajtow usuwanych).
+// - Kroki Trim zapamietuja zbior bajtow wejsciowych, ktore w danym miejscu potoku bylyby bialymi
+//   znakami lub juz usunietymi - przyciecie zawezaja wtedy zakres wejscia przed przebiegiem.
+//
+// Uwagi projektowe:
+// * Wynik jest identyczny z wywolaniem odpowiednich funkcji z strutils.h po kolei (TrimStr,
+//   ToLowercase, ToUppercase, ReplaceChar, RemoveSetOfChars), takze gdy Trim wystepuje
+//   pomiedzy innymi krokami lub wielokrotnie.
+// * Budowa potoku kosztuje O(256) na krok - potok nalezy budowac raz i uzywac wielokrotnie.
+//
+
+class TextPipeline
+{
+public:
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie pustego potoku (przeksztalcenie tozsamosciowe).
+    //
+    TextPipeline()
+    {
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Krok: usuniecie bialych znakow z obu stron tekstu (jak TrimStr()).
+    //
+    TextPipeline& Trim()
+    {
+        CharSet skip;
+        // Zbior bajtow wejsciowych, ktore na tym etapie sa juz usuniete lub sa bialymi znakami
+        for (cardinal b = 0; b < 256; b++) {
+            if (chars_.Deletes(char(b)) || IsAsciiWhitespace(chars_.TranslateChar(char(b))))
+                skip.Insert(char(b));
+        }
+        trims_.push_back(skip);
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Krok: zamiana wielkich liter ASCII na male (jak ToLowercase()).
+    //
+    TextPipeline& Lower()
+    {
+        chars_.Then(CharTranslator::Lowercase());
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Krok: zamiana malych liter ASCII na wielkie (jak ToUppercase()).
+    //
+    TextPipeline& Upper()
+    {
+        chars_.Then(CharTranslator::Uppercase());
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Krok: zamiana wystapien znaku <from> na <to> (jak ReplaceChar()).
+    //
+    TextPipeline& Replace(char from, char to)
+    {
+        chars_.Then(CharTranslator().Map(from, to));
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Krok: usuniecie znakow nalezacych do zbioru (jak RemoveSetOfChars()).
+    //
+    TextPipeline& Remove(const CharSet& charset)
+    {
+        // Bajt wejsciowy jest usuwany, jesli na tym etapie odwzorowuje sie na znak ze zbioru
+        chars_.Then(CharTranslator().Delete(charset));
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Krok: usuniecie znakow podanych w lancuchu <charset> (C-string, NULL = brak zmian).
+    //
+    TextPipeline& Remove(const char* charset)
+    {
+        return Remove(CharSet(charset));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Krok: usuniecie wszystkich wystapien danego znaku (jak RemoveChar()).
+    //
+    TextPipeline& Remove(char ch)
+    {
+        return Remove(CharSet(&ch, 1));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Wykonanie potoku na tekscie <in>, z zapisem wyniku do <out> (poprzednia tresc <out> jest
+    // zastepowana, a jego bufor uzywany ponownie). <in> nie moze wskazywac na tresc <out>.
+    //
+    void ApplyTo(StrView in, string& out) const
+    {
+        // Wyznaczenie zakresu wejscia pozostalego po wszystkich przycieciach
+        const StrView range = TrimmedRange(in);
+        // Przygotowanie bufora wynikowego (wynik nie bedzie dluzszy niz zakres wejscia)
+        out.resize(range.size());
+        if (range.empty()) return;
+
+        out.resize(TransformChars(range.data(), range.size(), &out[0]));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Wykonanie potoku na tekscie <in> (zwraca nowy tekst).
+    //
+    string Apply(StrView in) const
+    {
+        string out;
+        ApplyTo(in, out);
+        return out;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Wykonanie potoku na tekscie <str> (modyfikacja in-place, bez dodatkowego bufora).
+    //
+    void ApplyInPlace(string& str) const
+    {
+        if (str.empty()) return;
+
+        const StrView range = TrimmedRange(str);
+        // Zapis nigdy nie wyprzedza odczytu, wiec wynik moze trafic od razu na poczatek tekstu
+        const cardinal n = range.empty() ? 0 : TransformChars(range.data(), range.size(), &str[0]);
+        str.resize(n);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Liczba krokow Trim oraz zbior bajtow wejsciowych pomijanych przez <k>-ty z nich
+    // (dla przetwarzania strumieniowego - patrz textstream.h).
+    //
+    cardinal TrimCount() const { return trims_.size(); }
+    const CharSet& TrimSkipSet(cardinal k) const { return trims_[k]; }
+
+    //---------------------------------------------------------------------------------------------
+    // Jeden przebieg krokow znakowych po <n> znakach <src>: odwzorowanie bajtow i pominiecie
+    // usunietych (bez krokow Trim). Dopuszczalne dst <= src. Zwraca liczbe zapisanych znakow.
+    //
+    cardinal TransformChars(const char* src, cardinal n, char* dst) const
+    {
+        return chars_.TranslateBlock(src, n, dst);
+    }
+
+private:
+    //---------------------------------------------------------------------------------------------
+    // Zakres wejscia pozostaly po kolejnych krokach Trim (kazdy zaweza wynik poprzedniego).
+    //
+    StrView TrimmedRange(StrView in) const
+    {
+        cardinal b = 0, e = in.size();
+        for (cardinal k = 0; k < trims_.size(); k++) {
+            const CharSet& skip = trims_[k];
+            while (b < e && skip.Contains(in[b])) b++;
+            while (e > b && skip.Contains(in[e -1])) e--;
+        }
+        return in.substr(b, e - b);
+    }
+
+    CharTranslator chars_;         // zlozenie krokow znakowych
+    std::vector<CharSet> trims_;   // zbiory bajtow pomijanych przez kolejne kroki Trim
+};
+
+
+} // namespace cans
+
+
+#endif // CA_TEXTPIPELINE_H
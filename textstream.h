@@ -0,0 +1,277 @@
+#ifndef CA_TEXTSTREAM_H
+#define CA_TEXTSTREAM_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <cstring>       -> memchr()
+//   <istream>       -> std::istream
+//   <ostream>       -> std::ostream
+//   <string>        -> std::string
+//   <vector>        -> std::vector
+//
+// POSIX (tylko systemy uniksowe)
+//   <unistd.h>      -> read(), write()
+//   <cerrno>        -> errno, EINTR
+//
+// Repository
+//   "numutils.h"    -> cardinal
+//   "charset.h"     -> CharSet
+//   "textpipeline.h"-> TextPipeline
+//
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "numutils.h"
+#include "charset.h"
+#include "textpipeline.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CA_HAS_POSIX_IO 1
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+
+
+
+namespace cans
+{
+    using std::string;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Strumieniowe przeksztalcanie tekstu
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Wykonanie potoku TextPipeline na danych dowolnej wielkosci, podawanych porcjami (z pliku,
+//   strumienia lub bufora wywolujacego), przy ograniczonym zuzyciu pamieci.
+//
+// Zakres odpowiedzialnosci:
+// - Kroki znakowe potoku dzialaja na calym strumieniu.
+// - Kroki Trim dzialaja na kazdej linii osobno (linia = znaki do '\n'; sam znak '\n' przechodzi
+//   tylko przez kroki znakowe). Biale znaki moga byc rozdzielone granica porcji - stan linii
+//   przenoszony jest miedzy wywolaniami Feed().
+//
+// Uwagi projektowe:
+// * Wynik jest identyczny z TextPipeline::Apply() wykonanym na kazdej linii z osobna.
+// * Zatrzymywane sa tylko znaki, o ktorych nie wiadomo jeszcze, czy nie zostana przyciete na
+//   koncu linii (ciag bialych znakow za ostatnim znakiem "pewnym"). Poza tym zuzycie pamieci
+//   jest ograniczone rozmiarem porcji.
+//
+
+class TextStreamTransformer
+{
+public:
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie przeksztalcenia strumieniowego dla potoku <pipeline> (potok jest kopiowany).
+    //
+    explicit TextStreamTransformer(const TextPipeline& pipeline)
+        : pipeline_(pipeline), stage_(0)
+    {
+        // Suma zbiorow pomijanych przez kroki Trim: znak spoza niej nie zostanie przyciety
+        // z zadnej strony, wiec moze byc wyslany od razu
+        for (cardinal k = 0; k < pipeline_.TrimCount(); k++) {
+            for (cardinal b = 0; b < 256; b++) {
+                if (pipeline_.TrimSkipSet(k).Contains(char(b)))
+                    skipAny_.Insert(char(b));
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Przetworzenie kolejnej porcji <n> znakow. Wynik jest dopisywany na koniec <out>.
+    //
+    void Feed(const char* p, cardinal n, string& out)
+    {
+        cardinal i = 0;
+        // Dopoki porcja nie zostanie przetworzona, iteracja po fragmentach linii ...
+        while (i < n)
+        {
+            const char* nl = static_cast<const char*>(memchr(p + i, '\n', n - i));
+            const cardinal e = nl ? static_cast<cardinal>(nl - p) : n;
+            // ... przetworzenie tresci linii (do konca porcji lub do '\n'), ...
+            FeedLine(p + i, e - i, out);
+            if (!nl) break;
+            // ... a po napotkaniu konca linii - domkniecie jej i przepuszczenie '\n'
+            EndLine(out);
+            Emit("\n", 1, out);
+            i = e + 1;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Zakonczenie strumienia - domkniecie ostatniej linii (bez '\n'). Wynik dopisywany do <out>.
+    //
+    void Finish(string& out)
+    {
+        EndLine(out);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Porzucenie stanu biezacej linii (np. przed przetwarzaniem nowego strumienia).
+    //
+    void Reset()
+    {
+        stage_ = 0;
+        pending_.clear();
+    }
+
+private:
+    //---------------------------------------------------------------------------------------------
+    // Przetworzenie fragmentu tresci linii (bez '\n').
+    //
+    void FeedLine(const char* p, cardinal n, string& out)
+    {
+        const cardinal trims = pipeline_.TrimCount();
+        cardinal i = 0;
+
+        // Poczatek linii: kolejne kroki Trim pomijaja znaki ze swoich zbiorow
+        while (i < n && stage_ < trims) {
+            if (pipeline_.TrimSkipSet(stage_).Contains(p[i]))
+                i++;
+            else
+                stage_++;
+        }
+        if (i == n) return;
+
+        // Wyszukanie ostatniego znaku "pewnego" (spoza wszystkich zbiorow pomijanych) ...
+        cardinal last = n;
+        while (last > i && skipAny_.Contains(p[last -1])) last--;
+        // ... jesli jest, wyslanie zatrzymanych znakow i fragmentu do niego wlacznie, ...
+        if (last > i) {
+            Emit(pending_.data(), pending_.size(), out);
+            pending_.clear();
+            Emit(p + i, last - i, out);
+            i = last;
+        }
+        // ... a reszta zatrzymana do rozstrzygniecia (moze zostac przycieta na koncu linii)
+        pending_.append(p + i, n - i);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Domkniecie linii: przyciecie konca zatrzymanych znakow kolejnymi krokami Trim.
+    //
+    void EndLine(string& out)
+    {
+        cardinal e = pending_.size();
+        for (cardinal k = 0; k < pipeline_.TrimCount(); k++) {
+            while (e > 0 && pipeline_.TrimSkipSet(k).Contains(pending_[e -1])) e--;
+        }
+        Emit(pending_.data(), e, out);
+        Reset();
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Dopisanie do <out> wyniku krokow znakowych potoku dla <n> znakow <p>.
+    //
+    void Emit(const char* p, cardinal n, string& out) const
+    {
+        if (n == 0) return;
+
+        const cardinal base = out.size();
+        out.resize(base + n);
+        out.resize(base + pipeline_.TransformChars(p, n, &out[base]));
+    }
+
+    TextPipeline pipeline_;
+    CharSet skipAny_;      // suma zbiorow pomijanych przez wszystkie kroki Trim
+    cardinal stage_;       // liczba krokow Trim zakonczonych na poczatku biezacej linii
+    string pending_;       // znaki zatrzymane (byc moze do przyciecia na koncu linii)
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Przeksztalcenie calego strumienia <in> potokiem <pipeline> z zapisem do <out>, porcjami po
+// <chunkSize> znakow. Zwraca false przy bledzie odczytu <in> (badbit - wynik jest wtedy
+// niepelny, jak w TransformFd()) lub gdy zapis do <out> sie nie powiodl.
+//
+inline bool TransformStream(std::istream& in, std::ostream& out, const TextPipeline& pipeline,
+                            cardinal chunkSize = 65536)
+{
+    TextStreamTransformer transformer(pipeline);
+    std::vector<char> buf(chunkSize ? chunkSize : 1);
+    string result;
+
+    // Dopoki strumien wejsciowy dostarcza dane ...
+    while (in) {
+        in.read(&buf[0], static_cast<std::streamsize>(buf.size()));
+        const cardinal n = static_cast<cardinal>(in.gcount());
+        if (n == 0) break;
+        // ... przeksztalcenie porcji i zapis wyniku
+        result.clear();
+        transformer.Feed(&buf[0], n, result);
+        out.write(result.data(), static_cast<std::streamsize>(result.size()));
+        if (!out) return false;
+    }
+    // Blad odczytu (w odroznieniu od konca danych) - bez domykania linii
+    if (in.bad()) return false;
+
+    // Domkniecie ostatniej linii
+    result.clear();
+    transformer.Finish(result);
+    out.write(result.data(), static_cast<std::streamsize>(result.size()));
+    return static_cast<bool>(out);
+}
+
+
+#if defined(CA_HAS_POSIX_IO)
+
+//-------------------------------------------------------------------------------------------------
+// Helper: zapis calego bufora do deskryptora (z ponawianiem zapisow czesciowych i po EINTR)
+//
+inline bool WriteAllFd(int fd, const char* p, cardinal n)
+{
+    while (n > 0) {
+        const ssize_t w = ::write(fd, p, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += w;
+        n -= static_cast<cardinal>(w);
+    }
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Przeksztalcenie danych z deskryptora <inFd> potokiem <pipeline> z zapisem do <outFd>,
+// porcjami po <chunkSize> znakow. Zwraca false przy bledzie odczytu lub zapisu.
+//
+inline bool TransformFd(int inFd, int outFd, const TextPipeline& pipeline,
+                        cardinal chunkSize = 65536)
+{
+    TextStreamTransformer transformer(pipeline);
+    std::vector<char> buf(chunkSize ? chunkSize : 1);
+    string result;
+
+    for (;;) {
+        const ssize_t r = ::read(inFd, &buf[0], buf.size());
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (r == 0) break;
+        result.clear();
+        transformer.Feed(&buf[0], static_cast<cardinal>(r), result);
+        if (!WriteAllFd(outFd, result.data(), result.size())) return false;
+    }
+    result.clear();
+    transformer.Finish(result);
+    return WriteAllFd(outFd, result.data(), result.size());
+}
+
+#endif // CA_HAS_POSIX_IO
+
+
+} // namespace cans
+
+
+#endif // CA_TEXTSTREAM_H
@@ -0,0 +1,436 @@
+//-------------------------------------------------------------------------------------------------
+// cafilter - wsadowy filtr tekstu oparty o strutils.h / strconverters.h
+//
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <condition_variable>, <mutex>, <thread> -> potok etapow odczyt / przeksztalcenie / zapis
+//   <cstdio>        -> fopen(), fread(), fwrite(), fprintf()
+//   <cstdlib>       -> atoi()
+//   <cstring>       -> strcmp(), memchr()
+//   <deque>         -> std::deque
+//   <string>        -> std::string
+//   <vector>        -> std::vector
+//
+// POSIX (tylko systemy uniksowe)
+//   <sys/mman.h>, <sys/stat.h>, <fcntl.h>, <unistd.h> -> mmap(), fstat(), open(), close()
+//
+// Repository
+//   "textpipeline.h"   -> TextPipeline
+//   "textstream.h"     -> TextStreamTransformer
+//   "strconverters.h"  -> StrToInt(), StrToDbl(), RomanNumStrToInt(), AlphaNumStrToInt(),
+//                         IntToChars(), IntToRomanChars(), IntToAlphaChars(), DblToCharsFixed(),
+//                         kDblFixedCharsMax, StrView
+//
+// Budowa (cel "cafilter" w Makefile):
+//   make cafilter
+//   c++ -std=c++11 -O2 -pthread -I. tools/cafilter.cpp -o cafilter
+//
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CA_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "textpipeline.h"
+#include "textstream.h"
+#include "strconverters.h"
+
+using namespace cans;
+
+
+//-------------------------------------------------------------------------------------------------
+// Kolejka o ograniczonej pojemnosci, laczaca sasiednie etapy potoku.
+// Push() blokuje, gdy kolejka jest pelna; Pop() - gdy jest pusta.
+//
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(cardinal capacity) : capacity_(capacity) {}
+
+    void Push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this] { return items_.size() < capacity_; });
+        items_.push_back(item);
+        notEmpty_.notify_one();
+    }
+
+    T Pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return !items_.empty(); });
+        T item = items_.front();
+        items_.pop_front();
+        notFull_.notify_one();
+        return item;
+    }
+
+private:
+    const cardinal capacity_;
+    std::deque<T> items_;
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Porcja danych przekazywana miedzy etapami: widok na mapowany plik albo wlasny bufor.
+//
+struct TChunk
+{
+    const char* data;
+    cardinal size;
+    string buf;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersje wartosci wykonywane na kazdej linii (po przeksztalceniach tekstowych)
+//
+enum LineConversion
+{
+    ConvertNone,
+    ConvertToRoman,     // liczba calkowita -> numeracja rzymska
+    ConvertFromRoman,   // numeracja rzymska -> liczba calkowita
+    ConvertToAlpha,     // liczba calkowita -> numeracja literowa
+    ConvertFromAlpha,   // numeracja literowa -> liczba calkowita
+    ConvertFixed        // liczba rzeczywista -> zapis fixed z zadana liczba miejsc dziesietnych
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Opcje wywolania programu
+//
+struct TOptions
+{
+    TextPipeline pipeline;
+    LineConversion conversion;
+    short decimals;
+    cardinal chunkSize;
+    const char* input;
+    const char* output;
+
+    TOptions() : conversion(ConvertNone), decimals(8), chunkSize(1 << 20), input(NULL), output(NULL) {}
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja wartosci w pojedynczej linii <line> z dopisaniem wyniku do <out>; linie, ktorych nie
+// da sie zinterpretowac, zostaja bez zmian. Wynik zapisywany jest przez funkcje XxxToChars()
+// do bufora na stosie - bez alokacji tekstu na kazda linie.
+//
+static void ConvertLine(const TOptions& opt, StrView line, string& out)
+{
+    int i = 0;
+    double d = 0.0;
+    char buf[kDblFixedCharsMax];   // najwiekszy z wynikow XxxToChars() ponizej
+    char* e = buf;
+
+    switch (opt.conversion)
+    {
+        case ConvertToRoman:
+            if (StrToInt(line, i)) e = IntToRomanChars(i, buf);
+            break;
+        case ConvertFromRoman:
+            if (RomanNumStrToInt(line, i)) e = IntToChars(i, buf);
+            break;
+        case ConvertToAlpha:
+            if (StrToInt(line, i)) e = IntToAlphaChars(i, buf);
+            break;
+        case ConvertFromAlpha:
+            if (AlphaNumStrToInt(line, i)) e = IntToChars(i, buf);
+            break;
+        case ConvertFixed:
+            if (StrToDbl(line, d)) e = DblToCharsFixed(d, opt.decimals, buf);
+            break;
+        default:
+            break;
+    }
+    if (e == buf) out.append(line.data(), line.size());
+    else out.append(buf, static_cast<cardinal>(e - buf));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Konwersja wszystkich pelnych linii porcji <text>; niedokonczona linia przenoszona jest
+// w <carry> do nastepnej porcji (lub do konca strumienia, gdy <last>). Linie lezace w calosci
+// w porcji konwertowane sa bezposrednio z <text> (bez kopiowania do <carry>).
+//
+static void ConvertLines(const TOptions& opt, const string& text, bool last, string& carry,
+                         string& out)
+{
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const char* nl = static_cast<const char*>(memchr(p, '\n', static_cast<cardinal>(end - p)));
+        if (!nl) break;
+        if (carry.empty()) {
+            ConvertLine(opt, StrView(p, static_cast<cardinal>(nl - p)), out);
+        }
+        else {
+            // Dokonczenie linii rozpoczetej w poprzedniej porcji
+            carry.append(p, nl);
+            ConvertLine(opt, carry, out);
+            carry.clear();
+        }
+        out.push_back('\n');
+        p = nl + 1;
+    }
+    carry.append(p, end);
+    if (last && !carry.empty()) {
+        ConvertLine(opt, carry, out);
+        carry.clear();
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Zrodlo danych: plik mapowany w pamieci (gdy mozliwe) albo odczyt strumieniowy.
+//
+class TInput
+{
+public:
+    TInput() : file_(NULL), map_(NULL), size_(0), offset_(0), failed_(false) {}
+
+    ~TInput()
+    {
+#if defined(CA_HAS_MMAP)
+        if (map_) munmap(map_, size_);
+#endif
+        if (file_ && file_ != stdin) fclose(file_);
+    }
+
+    bool Open(const char* path)
+    {
+#if defined(CA_HAS_MMAP)
+        // Proba mapowania zwyklego pliku (odczyt sekwencyjny - podpowiedz dla systemu)
+        if (path) {
+            const int fd = ::open(path, O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+                void* p = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    map_ = p;
+                    size_ = static_cast<cardinal>(st.st_size);
+                    madvise(map_, size_, MADV_SEQUENTIAL);
+                }
+            }
+            ::close(fd);
+            if (map_) return true;
+        }
+#endif
+        // Zwykly odczyt (stdin, potoki, pliki puste lub niemapowalne)
+        file_ = path ? fopen(path, "rb") : stdin;
+        return file_ != NULL;
+    }
+
+    // Wypelnienie porcji kolejnym fragmentem danych; false = koniec danych lub blad odczytu
+    // (rozroznia je Failed())
+    bool Read(TChunk& chunk, cardinal chunkSize)
+    {
+        if (map_) {
+            if (offset_ >= size_) return false;
+            const char* base = static_cast<const char*>(map_);
+            chunk.data = base + offset_;
+            chunk.size = (size_ - offset_ < chunkSize) ? size_ - offset_ : chunkSize;
+            offset_ += chunk.size;
+            // Dotkniecie kazdej strony porcji - wczytanie danych z dysku odbywa sie w tym etapie,
+            // rownolegle z przeksztalcaniem poprzednich porcji
+            volatile char sink = 0;
+            for (cardinal i = 0; i < chunk.size; i += 4096) sink = sink ^ chunk.data[i];
+            return true;
+        }
+        chunk.buf.resize(chunkSize);
+        const size_t n = fread(&chunk.buf[0], 1, chunkSize, file_);
+        if (n == 0) {
+            failed_ = ferror(file_) != 0;
+            return false;
+        }
+        chunk.data = chunk.buf.data();
+        chunk.size = n;
+        return true;
+    }
+
+    // Czy odczyt zakonczyl sie bledem (a nie koncem danych)
+    bool Failed() const { return failed_; }
+
+private:
+    FILE* file_;
+    void* map_;
+    cardinal size_;
+    cardinal offset_;
+    bool failed_;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Potok trzech etapow (odczyt -> przeksztalcenie -> zapis) polaczonych kolejkami o ograniczonej
+// pojemnosci. Porcje krazace miedzy etapami sa uzywane wielokrotnie (brak alokacji na porcje).
+//
+static bool Run(const TOptions& opt)
+{
+    TInput input;
+    if (!input.Open(opt.input)) {
+        fprintf(stderr, "cafilter: cannot open input '%s'\n", opt.input);
+        return false;
+    }
+    FILE* out = opt.output ? fopen(opt.output, "wb") : stdout;
+    if (!out) {
+        fprintf(stderr, "cafilter: cannot open output '%s'\n", opt.output);
+        return false;
+    }
+
+    const cardinal kDepth = 4;
+    std::vector<TChunk> inChunks(kDepth), outChunks(kDepth);
+    BoundedQueue<TChunk*> inFree(kDepth), inFull(kDepth), outFree(kDepth), outFull(kDepth);
+    for (cardinal i = 0; i < kDepth; i++) {
+        inFree.Push(&inChunks[i]);
+        outFree.Push(&outChunks[i]);
+    }
+
+    // Etap 1: odczyt (NULL w kolejce oznacza koniec danych)
+    std::thread reader([&] {
+        for (;;) {
+            TChunk* chunk = inFree.Pop();
+            if (!input.Read(*chunk, opt.chunkSize)) break;
+            inFull.Push(chunk);
+        }
+        inFull.Push(NULL);
+    });
+
+    // Etap 3: zapis
+    bool writeOk = true;
+    std::thread writer([&] {
+        for (;;) {
+            TChunk* chunk = outFull.Pop();
+            if (!chunk) break;
+            if (writeOk && fwrite(chunk->buf.data(), 1, chunk->buf.size(), out) != chunk->buf.size())
+                writeOk = false;
+            outFree.Push(chunk);
+        }
+    });
+
+    // Etap 2: przeksztalcenie (w biezacym watku)
+    TextStreamTransformer transformer(opt.pipeline);
+    string text, carry;
+    for (;;) {
+        TChunk* in = inFull.Pop();
+        TChunk* result = outFree.Pop();
+        result->buf.clear();
+
+        // Przeksztalcenia tekstowe (stan linii przenoszony miedzy porcjami) ...
+        string& target = (opt.conversion == ConvertNone) ? result->buf : text;
+        target.clear();
+        if (in) {
+            transformer.Feed(in->data, in->size, target);
+            inFree.Push(in);
+        }
+        else {
+            transformer.Finish(target);
+        }
+        // ... i ewentualne konwersje wartosci w pelnych liniach
+        if (opt.conversion != ConvertNone)
+            ConvertLines(opt, text, in == NULL, carry, result->buf);
+
+        outFull.Push(result);
+        if (!in) break;
+    }
+    outFull.Push(NULL);
+
+    reader.join();
+    writer.join();
+
+    if (out != stdout) {
+        if (fclose(out) != 0) writeOk = false;
+    }
+    else if (fflush(out) != 0) {
+        writeOk = false;
+    }
+    if (!writeOk) fprintf(stderr, "cafilter: write error\n");
+    if (input.Failed()) fprintf(stderr, "cafilter: read error\n");
+    return writeOk && !input.Failed();
+}
+
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "usage: cafilter [options] [input [output]]\n"
+        "\n"
+        "Text transforms (applied in the given order):\n"
+        "  --trim                trim whitespace on both sides of every line\n"
+        "  --lower, --upper      convert ASCII letters to lower/upper case\n"
+        "  --strip CHARS         remove every character listed in CHARS\n"
+        "  --replace FROM TO     replace character FROM with character TO\n"
+        "\n"
+        "Per-line value conversions (lines that do not parse are left unchanged):\n"
+        "  --to-roman, --from-roman   integer <-> Roman numeral\n"
+        "  --to-alpha, --from-alpha   integer <-> alphabetic numbering (A..Z, AA..)\n"
+        "  --fixed N                  reformat real numbers with N decimal places\n"
+        "\n"
+        "  --chunk BYTES         size of processing chunks (default 1 MiB)\n"
+        "Input and output default to stdin and stdout.\n");
+}
+
+
+int main(int argc, char** argv)
+{
+    TOptions opt;
+    int positional = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const bool hasArg = (i + 1 < argc);
+
+        if (!strcmp(a, "--trim"))       opt.pipeline.Trim();
+        else if (!strcmp(a, "--lower")) opt.pipeline.Lower();
+        else if (!strcmp(a, "--upper")) opt.pipeline.Upper();
+        else if (!strcmp(a, "--strip") && hasArg) opt.pipeline.Remove(argv[++i]);
+        else if (!strcmp(a, "--replace") && i + 2 < argc && argv[i + 1][0] && argv[i + 2][0]) {
+            opt.pipeline.Replace(argv[i + 1][0], argv[i + 2][0]);
+            i += 2;
+        }
+        else if (!strcmp(a, "--to-roman"))   opt.conversion = ConvertToRoman;
+        else if (!strcmp(a, "--from-roman")) opt.conversion = ConvertFromRoman;
+        else if (!strcmp(a, "--to-alpha"))   opt.conversion = ConvertToAlpha;
+        else if (!strcmp(a, "--from-alpha")) opt.conversion = ConvertFromAlpha;
+        else if (!strcmp(a, "--fixed") && hasArg) {
+            opt.conversion = ConvertFixed;
+            opt.decimals = static_cast<short>(ClampInt(atoi(argv[++i]), 0, 16));
+        }
+        else if (!strcmp(a, "--chunk") && hasArg) {
+            const int n = atoi(argv[++i]);
+            opt.chunkSize = static_cast<cardinal>(n > 0 ? n : 1);
+        }
+        else if (!strcmp(a, "-h") || !strcmp(a, "--help")) {
+            PrintUsage();
+            return 0;
+        }
+        else if (a[0] != '-' && positional == 0) { opt.input = a;  positional++; }
+        else if (a[0] != '-' && positional == 1) { opt.output = a; positional++; }
+        else {
+            fprintf(stderr, "cafilter: invalid argument '%s'\n", a);
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    return Run(opt) ? 0 : 1;
+}
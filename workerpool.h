@@ -0,0 +1,171 @@
+#ifndef CA_WORKERPOOL_H
+#define CA_WORKERPOOL_H
+
+//-------------------------------------------------------------------------------------------------
+// Zaleznosci (naglowki uzyte w tym module):
+//
+// C++ / STL
+//   <atomic>               -> std::atomic
+//   <condition_variable>   -> std::condition_variable
+//   <functional>           -> std::function
+//   <mutex>                -> std::mutex
+//   <thread>               -> std::thread
+//   <vector>               -> std::vector
+//
+// Repository
+//   "numutils.h"           -> cardinal
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "numutils.h"
+
+
+
+
+namespace cans
+{
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Dzial: Pula watkow roboczych
+// Warstwa: Model / Utilities
+//-------------------------------------------------------------------------------------------------
+// Cel:
+//   Staly zestaw watkow wykonujacych ponumerowane zadania (parallel-for). Watki tworzone sa raz,
+//   przy budowie puli, i uzywane przez kolejne wywolania Run().
+//
+// Uwagi projektowe:
+// * Watek wywolujacy Run() rowniez wykonuje zadania, a Run() wraca dopiero po ich zakonczeniu.
+// * Pula nie jest wspoldzielona niejawnie - kazdy uzytkownik tworzy i przekazuje wlasna.
+// * Run() nie moze byc wywolywane rownolegle z kilku watkow na tej samej puli.
+//
+
+class WorkerPool
+{
+public:
+    typedef std::function<void(cardinal)> Task;
+
+    //---------------------------------------------------------------------------------------------
+    // Utworzenie puli, w ktorej zadania wykonuje <threads> watkow (lacznie z wywolujacym).
+    // Wartosc 0 oznacza liczbe watkow sprzetowych.
+    //
+    explicit WorkerPool(cardinal threads = 0)
+        : task_(NULL), count_(0), next_(0), generation_(0), checkedOut_(0), stop_(false)
+    {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+
+        // Watki pomocnicze (watek wywolujacy jest jednym z wykonawcow)
+        for (cardinal i = 1; i < threads; i++)
+            workers_.push_back(std::thread(&WorkerPool::WorkerLoop, this));
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (cardinal i = 0; i < workers_.size(); i++)
+            workers_[i].join();
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Liczba watkow wykonujacych zadania (lacznie z wywolujacym).
+    //
+    cardinal Size() const { return workers_.size() + 1; }
+
+    //---------------------------------------------------------------------------------------------
+    // Wykonanie zadan task(0) .. task(count - 1) przez watki puli; powrot po zakonczeniu wszystkich.
+    //
+    void Run(cardinal count, const Task& task)
+    {
+        if (count == 0) return;
+        // Bez watkow pomocniczych lub dla jednego zadania - wykonanie w biezacym watku
+        if (workers_.empty() || count == 1) {
+            for (cardinal i = 0; i < count; i++) task(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            count_ = count;
+            next_ = 0;
+            checkedOut_ = 0;
+            generation_++;
+        }
+        wake_.notify_all();
+
+        // Udzial watku wywolujacego w wykonaniu zadan ...
+        Work(task, count);
+
+        // ... i oczekiwanie, az kazdy watek pomocniczy zakonczy biezaca generacje zadan
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return checkedOut_ == workers_.size(); });
+        task_ = NULL;
+    }
+
+private:
+    //---------------------------------------------------------------------------------------------
+    // Pobieranie kolejnych numerow zadan az do wyczerpania.
+    //
+    void Work(const Task& task, cardinal count)
+    {
+        for (cardinal i = next_++; i < count; i = next_++)
+            task(i);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    // Petla watku pomocniczego: oczekiwanie na nowa generacje zadan, udzial w niej, zgloszenie.
+    //
+    void WorkerLoop()
+    {
+        unsigned seen = 0;
+        for (;;)
+        {
+            const Task* task;
+            cardinal count;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                task = task_;
+                count = count_;
+            }
+
+            Work(*task, count);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                checkedOut_++;
+            }
+            done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;     // nowa generacja zadan lub zatrzymanie puli
+    std::condition_variable done_;     // watek pomocniczy zakonczyl generacje
+    const Task* task_;
+    cardinal count_;
+    std::atomic<cardinal> next_;       // numer nastepnego zadania do pobrania
+    unsigned generation_;
+    cardinal checkedOut_;              // liczba watkow pomocniczych, ktore zakonczyly generacje
+    bool stop_;
+};
+
+
+} // namespace cans
+
+
+#endif // CA_WORKERPOOL_H